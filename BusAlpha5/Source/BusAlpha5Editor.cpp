@@ -3,7 +3,7 @@
 BusAlpha5Editor::BusAlpha5Editor(BusAlpha5Processor& p)
     : AudioProcessorEditor(&p), processor(p)
 {
-    setSize(320, 280);
+    setSize(320, 320);
 
     // Channel selector
     channelLabel.setText("BUS CHANNEL", juce::dontSendNotification);
@@ -20,6 +20,27 @@ BusAlpha5Editor::BusAlpha5Editor(BusAlpha5Processor& p)
     channelIDAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         processor.getAPVTS(), "channelID", channelIDSelector);
 
+    channelNameEditor.setTextToShowWhenEmpty("name", juce::Colours::grey);
+    channelNameEditor.setText(processor.getChannelName(), juce::dontSendNotification);
+    channelNameEditor.onReturnKey = channelNameEditor.onFocusLost = [this] { processor.setChannelName(channelNameEditor.getText()); };
+    addAndMakeVisible(channelNameEditor);
+
+    // Send selector
+    sendLabel.setText("SEND TO", juce::dontSendNotification);
+    sendLabel.setJustificationType(juce::Justification::centred);
+    sendLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    sendLabel.setFont(juce::Font(14.0f, juce::Font::bold));
+    addAndMakeVisible(sendLabel);
+
+    sendSelector.addItem("Off", 1);
+    for (int i = 1; i <= 32; ++i)
+        sendSelector.addItem(juce::String(i), i + 1);
+    sendSelector.setSelectedId(1, juce::dontSendNotification);
+    addAndMakeVisible(sendSelector);
+
+    sendAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processor.getAPVTS(), "sendChannel", sendSelector);
+
     // Status displays
     statusLabel.setText("IDLE", juce::dontSendNotification);
     statusLabel.setJustificationType(juce::Justification::centred);
@@ -39,6 +60,11 @@ BusAlpha5Editor::BusAlpha5Editor(BusAlpha5Processor& p)
     bufferLevelLabel.setFont(juce::Font(12.0f));
     addAndMakeVisible(bufferLevelLabel);
 
+    healthLabel.setJustificationType(juce::Justification::centred);
+    healthLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    healthLabel.setFont(juce::Font(11.0f));
+    addAndMakeVisible(healthLabel);
+
     startTimerHz(30);
 }
 
@@ -55,8 +81,22 @@ void BusAlpha5Editor::timerCallback()
     bufferLevel = BusShared::getInstance().getNumAvailable(channelID);
     readCount = BusShared::getInstance().getTotalRead(channelID);
 
+    // A name overrides the number
+    const bool named = processor.getChannelName().isNotEmpty();
+    channelIDSelector.setEnabled(!named);
+
     // Update status
-    if (activeChannels > 0 && bufferLevel > 0)
+    if (!BusShared::getInstance().isInitialized())
+    {
+        statusLabel.setText(BusShared::getInstance().getStatusMessage(), juce::dontSendNotification);
+        statusLabel.setColour(juce::Label::textColourId, juce::Colours::red);
+    }
+    else if (named && !processor.isChannelNameResolved())
+    {
+        statusLabel.setText("NO FREE CHANNEL FOR NAME", juce::dontSendNotification);
+        statusLabel.setColour(juce::Label::textColourId, juce::Colours::red);
+    }
+    else if (activeChannels > 0 && bufferLevel > 0)
     {
         statusLabel.setText("● ACTIVE", juce::dontSendNotification);
         statusLabel.setColour(juce::Label::textColourId, juce::Colours::lime);
@@ -72,6 +112,62 @@ void BusAlpha5Editor::timerCallback()
     bufferLevelLabel.setText("Buffer: " + juce::String(bufferLevel) + " samples",
         juce::dontSendNotification);
 
+    // Our own load and the channel's xruns, plus any writer that stopped calling in
+    BusChannelHealth health;
+    if (BusShared::getInstance().getChannelHealth(channelID, health))
+    {
+        int stalledWriters = 0;
+        int soloedWriters = 0;
+
+        for (auto& lane : health.lanes)
+        {
+            if (lane.active && lane.stalled)
+                ++stalledWriters;
+
+            if (lane.active && lane.mix.soloed)
+                ++soloedWriters;
+        }
+
+        const float gainReduction = processor.getLimiter().getGainReductionDecibels();
+
+        juce::String text;
+        text << "CPU " << juce::roundToInt(health.reader.getLoad() * 100.0) << "% (peak "
+             << juce::roundToInt(health.reader.getPeakLoad() * 100.0) << "%)  Drift "
+             << juce::String(health.driftPpm, 1) << " ppm\n"
+             << "Fill " << health.fillLow << "-" << health.fillHigh
+             << "  Under " << (int)health.underruns << "  Over " << (int)health.getOverruns();
+
+        if (health.staleReads > 0)
+            text << "  Stale " << (int)health.staleReads;
+
+        if (stalledWriters > 0)
+            text << "  Stalled " << stalledWriters;
+
+        if (soloedWriters > 0)
+            text << "  Solo " << soloedWriters;
+
+        if (gainReduction < -0.1f)
+            text << "  Lim " << juce::String(gainReduction, 1) << " dB";
+
+        // Where we sit in the routing graph, and whether our send got through
+        auto& bus = BusShared::getInstance();
+        const int sendChannel = processor.getSendChannel();
+
+        if (processor.isSendRefused())
+            text << "\nSend to " << sendChannel << " refused: it would loop back";
+        else if (sendChannel > 0 || bus.getChannelDepth(channelID) > 0)
+            text << "\nDepth " << bus.getChannelDepth(channelID) << "  Path "
+                 << juce::String(bus.getPathLatencySeconds(channelID) * 1.0e3, 1) << " ms"
+                 << (sendChannel > 0 ? "  Send to " + juce::String(sendChannel) : juce::String());
+
+        healthLabel.setText(text, juce::dontSendNotification);
+        healthLabel.setColour(juce::Label::textColourId,
+            health.reader.getPeakLoad() > 0.8 ? juce::Colours::red
+            : processor.isSendRefused() || health.underruns > 0 || health.getOverruns() > 0
+                || health.staleReads > 0 || stalledWriters > 0 ? juce::Colours::orange
+            : juce::Colours::grey);
+    }
+
     repaint();
 }
 
@@ -118,9 +214,16 @@ void BusAlpha5Editor::resized()
 
     area.removeFromTop(35); // Title space
 
-    channelLabel.setBounds(area.removeFromTop(20));
+    auto labels = area.removeFromTop(20);
+    channelLabel.setBounds(labels.removeFromLeft(labels.getWidth() / 2));
+    sendLabel.setBounds(labels);
     area.removeFromTop(5);
-    channelIDSelector.setBounds(area.removeFromTop(24).reduced(60, 0));
+    auto selectors = area.removeFromTop(24);
+    auto channelArea = selectors.removeFromLeft(selectors.getWidth() / 2).reduced(10, 0);
+    channelIDSelector.setBounds(channelArea.removeFromLeft(56));
+    channelArea.removeFromLeft(4);
+    channelNameEditor.setBounds(channelArea);
+    sendSelector.setBounds(selectors.reduced(20, 0));
 
     area.removeFromTop(15);
     statusLabel.setBounds(area.removeFromTop(25));
@@ -130,4 +233,7 @@ void BusAlpha5Editor::resized()
 
     area.removeFromTop(45); // Space for buffer bar
     bufferLevelLabel.setBounds(area.removeFromTop(20));
+
+    area.removeFromTop(5);
+    healthLabel.setBounds(area.removeFromTop(46));
 }
\ No newline at end of file
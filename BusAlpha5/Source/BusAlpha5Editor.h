@@ -19,10 +19,16 @@ private:
     juce::Label channelLabel;
     juce::ComboBox channelIDSelector;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> channelIDAttachment;
+    juce::TextEditor channelNameEditor; // Named channel, used instead of the number when not empty
+
+    juce::Label sendLabel;
+    juce::ComboBox sendSelector; // Channel the mix is re-published to, e.g. a sub-group into the master
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> sendAttachment;
 
     juce::Label statusLabel;
     juce::Label activeChannelsLabel;
     juce::Label bufferLevelLabel;
+    juce::Label healthLabel; // Telemetry from the shared segment
 
     int activeChannels = 0;
     int bufferLevel = 0;
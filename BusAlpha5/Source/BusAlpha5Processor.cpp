@@ -7,9 +7,23 @@ BusAlpha5Processor::BusAlpha5Processor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
+    apvts.addParameterListener(PARAM_TARGET_LATENCY, this);
+    apvts.addParameterListener(PARAM_CHANNEL_ID, this);
+    apvts.addParameterListener(PARAM_SEND_CHANNEL, this);
+    updateSend();
+    startTimerHz(timerHz);
 }
 
-BusAlpha5Processor::~BusAlpha5Processor() = default;
+BusAlpha5Processor::~BusAlpha5Processor()
+{
+    stopTimer();
+    apvts.removeParameterListener(PARAM_TARGET_LATENCY, this);
+    apvts.removeParameterListener(PARAM_CHANNEL_ID, this);
+    apvts.removeParameterListener(PARAM_SEND_CHANNEL, this);
+
+    BusShared::getInstance().unregisterWriter(sendWriter.exchange({}));
+    BusShared::getInstance().removeRoute(sendRoute.exchange(-1));
+}
 
 juce::AudioProcessorValueTreeState::ParameterLayout BusAlpha5Processor::createParameterLayout()
 {
@@ -20,52 +34,226 @@ juce::AudioProcessorValueTreeState::ParameterLayout BusAlpha5Processor::createPa
         "Channel ID",
         1, 32, 1));
 
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ PARAM_TARGET_LATENCY, 1 },
+        "Target Latency",
+        juce::NormalisableRange<float>(2.0f, 250.0f, 0.1f, 0.5f),
+        20.0f,
+        juce::AudioParameterFloatAttributes().withLabel("ms")));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ PARAM_OUTPUT_GAIN, 1 },
+        "Output Gain",
+        juce::NormalisableRange<float>(-24.0f, 12.0f, 0.1f),
+        0.0f,
+        juce::AudioParameterFloatAttributes().withLabel("dB")));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ PARAM_LIMITER, 1 },
+        "Limiter",
+        true));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ PARAM_CEILING, 1 },
+        "Limiter Ceiling",
+        juce::NormalisableRange<float>(-12.0f, 0.0f, 0.1f),
+        -0.3f,
+        juce::AudioParameterFloatAttributes().withLabel("dB")));
+
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID{ PARAM_SEND_CHANNEL, 1 },
+        "Send To Channel",
+        0, 32, 0,
+        juce::AudioParameterIntAttributes().withStringFromValueFunction(
+            [](int value, int) { return value == 0 ? juce::String("Off") : juce::String(value); })));
+
     return { params.begin(), params.end() };
 }
 
-void BusAlpha5Processor::prepareToPlay(double, int) {}
+void BusAlpha5Processor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    // Lanes in other layouts are folded onto whatever speaker layout the host gave us
+    driftReader.prepare(sampleRate, samplesPerBlock, getChannelLayoutOfBus(false, 0));
+    outputGain.reset(sampleRate, 0.05);
+    outputGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(apvts.getRawParameterValue(PARAM_OUTPUT_GAIN)->load()));
+    limiter.prepare(sampleRate, samplesPerBlock);
+    latencyPending = false;
+    updateLatency();
+
+    // Changes made before the host started us (or with no message loop) don't wait for the timer
+    if (sendPending.exchange(false))
+        updateSend();
+
+    // Size the send ring for this host (not while the timer is replacing it)
+    const juce::ScopedLock sl(sendLock);
+    sendSampleRate = sampleRate;
+    sendBlockSize = samplesPerBlock;
+    BusShared::getInstance().prepareWriter(sendWriter.load(), sendSampleRate, sendBlockSize, getChannelLayoutOfBus(false, 0));
+}
+
+void BusAlpha5Processor::parameterChanged(const juce::String& parameterID, float)
+{
+    // All three are automatable, so this can be the audio thread: only flag the change here,
+    // the timer does the locking and allocating
+    if (parameterID == PARAM_TARGET_LATENCY)
+        latencyPending = true;
+    else if (parameterID == PARAM_CHANNEL_ID || parameterID == PARAM_SEND_CHANNEL)
+        sendPending = true;
+}
+
+void BusAlpha5Processor::timerCallback()
+{
+    // Filter tables for sources at rates prepareToPlay didn't expect
+    driftReader.updateKernels();
+
+    if (sendPending.exchange(false))
+        updateSend();
+
+    if (latencyPending.exchange(false))
+        updateLatency();
+
+    if (++timerTicks % timerHz != 0)
+        return;
+
+    BusShared::getInstance().reapDeadWriters();
+    BusShared::getInstance().releaseIdleRings();
+
+    if (resolveChannelName())
+        updateSend();
+}
+
+void BusAlpha5Processor::setChannelName(const juce::String& name)
+{
+    apvts.state.setProperty(PROPERTY_CHANNEL_NAME, name.trim(), nullptr);
+
+    if (resolveChannelName())
+        updateSend();
+}
+
+bool BusAlpha5Processor::resolveChannelName()
+{
+    const juce::String name = getChannelName();
+    const int channelID = name.isEmpty() ? 0 : BusShared::getInstance().acquireNamedChannel(name.toRawUTF8());
+
+    return namedChannelID.exchange(channelID) != channelID;
+}
+
+void BusAlpha5Processor::updateLatency()
+{
+    // Same figure the drift reader aims for: queued audio, plus the resampler's look-ahead
+    const double targetSeconds = apvts.getRawParameterValue(PARAM_TARGET_LATENCY)->load() * 0.001;
+    const int queuedSamples = BusDriftReader::getTargetLatencySamples(targetSeconds, getSampleRate(), getBlockSize());
+
+    setLatencySamples(queuedSamples + juce::roundToInt(BusResampler::getBaseLatency()));
+
+    // Downstream buses hold their direct senders back by this much more
+    BusShared::getInstance().setRouteLatency(sendRoute.load(), getHopLatencySeconds());
+}
+
+double BusAlpha5Processor::getHopLatencySeconds() const
+{
+    if (getSampleRate() > 0.0)
+        return getLatencySamples() / getSampleRate();
+
+    return apvts.getRawParameterValue(PARAM_TARGET_LATENCY)->load() * 0.001;
+}
+
+void BusAlpha5Processor::updateSend()
+{
+    auto& bus = BusShared::getInstance();
+    const juce::ScopedLock sl(sendLock);
+
+    // processBlock may still be sending through the old handle; unregisterWriter() waits for it
+    // before the ring is freed
+    bus.unregisterWriter(sendWriter.exchange({}));
+    bus.removeRoute(sendRoute.exchange(-1));
+    sendRefused = false;
+
+    const int target = getSendChannel();
+
+    if (target == 0)
+        return;
+
+    // The route goes in first, so a send that would feed back into us never gets a lane
+    const int route = bus.addRoute(getChannelID(), target, getHopLatencySeconds());
 
-void BusAlpha5Processor::releaseResources() {}
+    if (route < 0)
+    {
+        sendRefused = true;
+        return;
+    }
+
+    const BusWriterHandle writer = bus.registerWriter(target);
+
+    if (sendSampleRate > 0.0)
+        bus.prepareWriter(writer, sendSampleRate, sendBlockSize, getChannelLayoutOfBus(false, 0));
+
+    sendRoute = route;
+    sendWriter = writer;
+}
+
+void BusAlpha5Processor::releaseResources()
+{
+    driftReader.reset();
+    limiter.reset();
+}
 
 void BusAlpha5Processor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
 
-    // Clear output buffer first
-    buffer.clear();
+    const int64_t blockStartNanos = BusShared::getMonotonicNanos();
 
     int channelID = getChannelID();
     const int numSamples = buffer.getNumSamples();
 
-    // DEBUG: Log every 1000 blocks
-    static int debugCounter = 0;
-    if (++debugCounter >= 1000) {
-        debugCounter = 0;
-        int available = BusShared::getInstance().getNumAvailable(channelID);
-        int writers = BusShared::getInstance().getActiveWriters(channelID);
-        DBG("Bus Alpha: Ch " << channelID
-            << " | Writers: " << writers
-            << " | Available: " << available
-            << " | Shared Mem: " << (BusShared::getInstance().isInitialized() ? "YES" : "NO"));
-    }
-
-    // Read summed audio from shared memory for this channel
-    BusShared::getInstance().readFromChannel(
+    // Sum this channel straight from shared memory into the host buffer (which it overwrites),
+    // each source drift-corrected
+    driftReader.setTargetLatencySeconds(apvts.getRawParameterValue(PARAM_TARGET_LATENCY)->load() * 0.001);
+    driftReader.process(
         channelID,
-        buffer.getWritePointer(0),
-        buffer.getNumChannels() >= 2 ? buffer.getWritePointer(1) : nullptr,
+        buffer.getArrayOfWritePointers(),
+        buffer.getNumChannels(),
         numSamples
     );
 
+    // Headroom for the sum, then keep it from clipping the host
+    outputGain.setTargetValue(juce::Decibels::decibelsToGain(apvts.getRawParameterValue(PARAM_OUTPUT_GAIN)->load()));
+    outputGain.applyGain(buffer, numSamples);
+
+    if (apvts.getRawParameterValue(PARAM_LIMITER)->load() > 0.5f)
+    {
+        limiter.setCeilingDecibels(apvts.getRawParameterValue(PARAM_CEILING)->load());
+        limiter.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+    }
+    else
+    {
+        limiter.reset();
+    }
+
+    // Re-publish the finished mix downstream. Our play-out is steered by the drift loop, so
+    // it only lines up on the clock (not the timeline): stamp it as old as its audio really is.
+    const BusWriterHandle send = sendWriter.load();
+
+    if (send.isValid())
+    {
+        auto& bus = BusShared::getInstance();
+        const double latencySeconds = bus.getPathLatencySeconds(channelID) + getLatencySamples() / getSampleRate();
+
+        bus.writeToChannel(send, buffer.getArrayOfReadPointers(), buffer.getNumChannels(), numSamples, -1, latencySeconds);
+        bus.publishWriterTiming(send, blockStartNanos, numSamples);
+    }
+
     // Update active channel count for display
     activeChannelCount = BusShared::getInstance().getActiveWriters(channelID);
 
+    BusShared::getInstance().publishReaderTelemetry(channelID, blockStartNanos, numSamples, driftReader.getReport());
+
     // Prevent smart disable with tiny DC offset (CRITICAL for generators!)
     if (numSamples > 0)
     {
-        buffer.setSample(0, 0, buffer.getSample(0, 0) + 0.0000001f);
-        if (buffer.getNumChannels() >= 2)
-            buffer.setSample(1, 0, buffer.getSample(1, 0) + 0.0000001f);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            buffer.setSample(ch, 0, buffer.getSample(ch, 0) + 0.0000001f);
     }
 }
 
@@ -75,13 +263,20 @@ bool BusAlpha5Processor::isBusesLayoutSupported(const BusesLayout& layouts) cons
     if (layouts.getMainInputChannelSet() != juce::AudioChannelSet::disabled())
         return false;
 
+    // Any speaker layout (or discrete set) up to what a lane can carry
     const auto& out = layouts.getMainOutputChannelSet();
-    return out == juce::AudioChannelSet::stereo();
+    return !out.isDisabled() && out.size() <= busMaxChannels;
 }
 
 int BusAlpha5Processor::getChannelID() const
 {
-    return static_cast<int>(apvts.getRawParameterValue(PARAM_CHANNEL_ID)->load());
+    const int named = namedChannelID.load();
+    return named > 0 ? named : static_cast<int>(apvts.getRawParameterValue(PARAM_CHANNEL_ID)->load());
+}
+
+int BusAlpha5Processor::getSendChannel() const
+{
+    return static_cast<int>(apvts.getRawParameterValue(PARAM_SEND_CHANNEL)->load());
 }
 
 juce::AudioProcessorEditor* BusAlpha5Processor::createEditor()
@@ -106,6 +301,9 @@ void BusAlpha5Processor::setStateInformation(const void* data, int sizeInBytes)
         {
             auto state = juce::ValueTree::fromXml(*xmlState);
             apvts.replaceState(state);
+
+            if (resolveChannelName())
+                updateSend();
         }
     }
 }
@@ -1,8 +1,12 @@
 #pragma once
 #include <JuceHeader.h>
 #include "BusShared.h"
+#include "BusDriftReader.h"
+#include "BusLimiter.h"
 
-class BusAlpha5Processor : public juce::AudioProcessor
+class BusAlpha5Processor : public juce::AudioProcessor,
+    private juce::AudioProcessorValueTreeState::Listener,
+    private juce::Timer
 {
 public:
     BusAlpha5Processor();
@@ -36,15 +40,74 @@ public:
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
     int getChannelID() const;
+
+    // Named channel ("drums/kick") played instead of the numbered one while not empty.
+    // Saved with the state. Message thread only.
+    void setChannelName(const juce::String& name);
+    juce::String getChannelName() const { return apvts.state.getProperty(PROPERTY_CHANNEL_NAME).toString(); }
+    bool isChannelNameResolved() const { return namedChannelID.load() > 0; }
+    int getSendChannel() const;
+    bool isSendRefused() const { return sendRefused.load(); }
     int getActiveChannelCount() const { return activeChannelCount; }
+    const BusDriftReader& getDriftReader() const { return driftReader; }
+    const BusLimiter& getLimiter() const { return limiter; }
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    std::atomic<int> namedChannelID{ 0 }; // Channel ID the name was given, 0 when using the numbered one
     std::atomic<int> activeChannelCount{ 0 };
 
+    // Reads each source at its own clock-drift-corrected speed
+    BusDriftReader driftReader;
+
+    // Master section after the sum: output level, then the safety limiter
+    juce::SmoothedValue<float> outputGain{ 1.0f };
+    BusLimiter limiter;
+
+    // Our lane on the channel we re-publish the mix to, and the route that lets it through
+    // (sub-group into master). A route that would loop back is refused and the send stays off.
+    std::atomic<BusWriterHandle> sendWriter{ BusWriterHandle{} };
+    std::atomic<int> sendRoute{ -1 };
+    std::atomic<bool> sendRefused{ false };
+    // Host format the send ring is sized for (0 until prepareToPlay), and what keeps
+    // prepareToPlay and updateSend() from sizing and freeing the send at the same time
+    juce::CriticalSection sendLock;
+    double sendSampleRate = 0.0;
+    int sendBlockSize = 0;
+
     static constexpr const char* PARAM_CHANNEL_ID = "channelID";
+    static constexpr const char* PARAM_TARGET_LATENCY = "targetLatency";
+    static constexpr const char* PARAM_OUTPUT_GAIN = "outputGain";
+    static constexpr const char* PARAM_LIMITER = "limiter";
+    static constexpr const char* PARAM_CEILING = "ceiling";
+    static constexpr const char* PARAM_SEND_CHANNEL = "sendChannel";
+    static constexpr const char* PROPERTY_CHANNEL_NAME = "channelName";
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    // Applies parameter changes the listener flagged and designs resampler tables the drift
+    // reader is waiting for. Once a second it also frees the lanes of crashed hosts (the audio
+    // thread already leaves them out of the sum), hands the memory of idle lanes back to the
+    // OS and keeps our channel name alive.
+    void timerCallback() override;
+    static constexpr int timerHz = 10;
+    int timerTicks = 0;
+    std::atomic<bool> sendPending{ false };
+    std::atomic<bool> latencyPending{ false };
+
+    // Tells the host how far behind the senders we play, so it can compensate
+    void updateLatency();
+
+    // Seconds our output lags what the senders wrote: the delay our route adds
+    double getHopLatencySeconds() const;
+
+    // Drops the old send and route, then sets up the ones the parameters ask for
+    void updateSend();
+
+    // Looks our channel name up in the directory; true if that moved us to another channel
+    bool resolveChannelName();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BusAlpha5Processor)
 };
\ No newline at end of file
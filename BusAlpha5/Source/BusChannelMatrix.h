@@ -0,0 +1,244 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BusShared.h"
+
+// Maps a lane's speaker layout onto the reader's. A speaker the reader also has goes
+// straight through. One it lacks folds down at -3 dB onto the nearest speaker it does
+// have: surrounds onto the other surround variants, then the front; heights onto the
+// ear-level speaker below them; a centre is split over left/right, and anything left
+// over lands in the centre. LFE only ever reaches an LFE. Discrete, ambisonic and
+// unknown channels (and speakers with nowhere to go on a discrete output) map by index.
+// build() doesn't allocate, so the audio thread can rebuild it when a lane changes.
+class BusChannelMatrix
+{
+public:
+    static constexpr int maxEntries = 2 * busMaxChannels;
+
+    void build(const BusStreamFormat& source, const uint16_t* destTypes, int numDest) noexcept
+    {
+        numEntries = 0;
+
+        for (int s = 0; s < source.numChannels; ++s)
+        {
+            const int type = source.channelTypes[s];
+            const int direct = find(type, destTypes, numDest);
+
+            if (direct >= 0)
+            {
+                add(s, direct, 1.0f);
+                continue;
+            }
+
+            const bool speaker = isSpeaker(type);
+
+            if (speaker && fold(s, type, destTypes, numDest))
+                continue;
+
+            // Unplaced: by index, though a speaker (never an LFE) only lands on a discrete output
+            if (s < numDest && (!speaker || (!isSpeaker(destTypes[s]) && type != Set::LFE && type != Set::LFE2)))
+                add(s, s, 1.0f);
+        }
+    }
+
+    // Adds numSamples of every source channel, times gain, into the destination channels it maps to
+    void addTo(const float* const* source, float* const* dest, int numSamples, float gain = 1.0f) const noexcept
+    {
+        for (int i = 0; i < numEntries; ++i)
+        {
+            const auto& entry = entries[i];
+            const float entryGain = entry.gain * gain;
+
+            if (entryGain == 1.0f)
+                juce::FloatVectorOperations::add(dest[entry.dest], source[entry.source], numSamples);
+            else
+                juce::FloatVectorOperations::addWithMultiply(dest[entry.dest], source[entry.source], entryGain, numSamples);
+        }
+    }
+
+    int getNumEntries() const noexcept { return numEntries; }
+
+private:
+    using Set = juce::AudioChannelSet;
+
+    // One fallback: a single speaker, or a pair that shares the signal (second != unknown)
+    struct Step
+    {
+        int first;
+        int second;
+    };
+
+    struct Entry
+    {
+        int source = 0;
+        int dest = 0;
+        float gain = 1.0f;
+    };
+
+    static constexpr float foldGain = 0.70710678f;
+    static constexpr int maxSteps = 5;
+
+    void add(int source, int dest, float gain) noexcept
+    {
+        if (numEntries < maxEntries)
+            entries[numEntries++] = { source, dest, gain };
+    }
+
+    static int find(int type, const uint16_t* types, int numTypes) noexcept
+    {
+        for (int i = 0; i < numTypes; ++i)
+            if (types[i] == type)
+                return i;
+
+        return -1;
+    }
+
+    // Takes the first fallback the destination can play. Returns false if there was none.
+    bool fold(int source, int type, const uint16_t* destTypes, int numDest) noexcept
+    {
+        Step steps[maxSteps];
+        const int numSteps = getFallbacks(type, steps);
+
+        for (int i = 0; i < numSteps; ++i)
+        {
+            const int first = find(steps[i].first, destTypes, numDest);
+
+            if (steps[i].second == Set::unknown)
+            {
+                if (first >= 0)
+                {
+                    add(source, first, foldGain);
+                    return true;
+                }
+
+                continue;
+            }
+
+            const int second = find(steps[i].second, destTypes, numDest);
+
+            if (first >= 0 && second >= 0)
+            {
+                add(source, first, foldGain);
+                add(source, second, foldGain);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static int getFallbacks(int type, Step* steps) noexcept
+    {
+        int n = 0;
+        auto step = [&](int first, int second = Set::unknown) { steps[n++] = { first, second }; };
+
+        switch (type)
+        {
+            case Set::left:
+            case Set::right:
+                step(Set::centre);
+                break;
+
+            case Set::centre:
+                step(Set::left, Set::right);
+                break;
+
+            case Set::leftCentre:
+            case Set::wideLeft:
+            case Set::topFrontLeft:
+                step(Set::left);
+                step(Set::centre);
+                break;
+
+            case Set::rightCentre:
+            case Set::wideRight:
+            case Set::topFrontRight:
+                step(Set::right);
+                step(Set::centre);
+                break;
+
+            case Set::LFE:
+                step(Set::LFE2);
+                break;
+
+            case Set::LFE2:
+                step(Set::LFE);
+                break;
+
+            case Set::leftSurround:
+                step(Set::leftSurroundSide);
+                step(Set::leftSurroundRear);
+                step(Set::left);
+                step(Set::centre);
+                break;
+
+            case Set::rightSurround:
+                step(Set::rightSurroundSide);
+                step(Set::rightSurroundRear);
+                step(Set::right);
+                step(Set::centre);
+                break;
+
+            case Set::leftSurroundSide:
+            case Set::topSideLeft:
+                step(Set::leftSurround);
+                step(Set::leftSurroundRear);
+                step(Set::left);
+                step(Set::centre);
+                break;
+
+            case Set::rightSurroundSide:
+            case Set::topSideRight:
+                step(Set::rightSurround);
+                step(Set::rightSurroundRear);
+                step(Set::right);
+                step(Set::centre);
+                break;
+
+            case Set::leftSurroundRear:
+            case Set::topRearLeft:
+                step(Set::leftSurround);
+                step(Set::leftSurroundSide);
+                step(Set::left);
+                step(Set::centre);
+                break;
+
+            case Set::rightSurroundRear:
+            case Set::topRearRight:
+                step(Set::rightSurround);
+                step(Set::rightSurroundSide);
+                step(Set::right);
+                step(Set::centre);
+                break;
+
+            case Set::centreSurround:
+            case Set::topRearCentre:
+                step(Set::centreSurround);
+                step(Set::leftSurround, Set::rightSurround);
+                step(Set::leftSurroundRear, Set::rightSurroundRear);
+                step(Set::left, Set::right);
+                step(Set::centre);
+                break;
+
+            case Set::topMiddle:
+            case Set::topFrontCentre:
+                step(Set::centre);
+                step(Set::left, Set::right);
+                break;
+
+            default:
+                break;
+        }
+
+        return n;
+    }
+
+    // Channels with a place in the room, as opposed to discrete or ambisonic ones
+    static bool isSpeaker(int type) noexcept
+    {
+        Step steps[maxSteps];
+        return getFallbacks(type, steps) > 0;
+    }
+
+    Entry entries[maxEntries];
+    int numEntries = 0;
+};
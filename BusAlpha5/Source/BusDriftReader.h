@@ -0,0 +1,526 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <limits>
+#include "BusShared.h"
+#include "BusResampler.h"
+#include "BusChannelMatrix.h"
+
+static_assert(BusResampler::maxChannels == busMaxChannels, "A lane must fit the resampler");
+
+// Reads every source lane on a channel at its own, slowly adapted speed, so each one
+// sits near the target latency even when the sending host's audio clock drifts from ours.
+// A PI loop on the lane's fill level steers a polyphase variable-ratio resampler, which
+// also converts lanes whose writer runs at a different sample rate from ours;
+// underruns re-prime the lane instead of clicking, and a runaway backlog is dropped.
+// Lanes are also aligned to each other using the stamps their writers publish: lanes
+// from one host line up on its play head timeline, the rest on the shared clock.
+// Each lane is resampled in its own layout and then mapped onto ours (BusChannelMatrix),
+// at the level, mute and solo its writer publishes (BusLaneMix).
+// The resampler's filter tables are designed off the audio thread: the usual rates in
+// prepare(), any other a lane turns up with by updateKernels() (that lane waits meanwhile).
+// Audio the writer overwrote while we were resampling it is thrown away, never played:
+// a lane that drops out, for that or an underrun, fades from its last sample to silence.
+class BusDriftReader
+{
+public:
+    // Largest correction the loop may apply (0.5% = ~8.6 cents, far beyond real clock drift)
+    static constexpr double maxRatioDeviation = 0.005;
+
+    // Widest rate mismatch we convert (e.g. 384 kHz into 48 kHz); lanes beyond it stay silent
+    static constexpr double maxRateRatio = 8.0;
+
+    void prepare(double newSampleRate, int newMaximumBlockSize,
+                 const juce::AudioChannelSet& outputLayout = juce::AudioChannelSet::stereo())
+    {
+        sampleRate = newSampleRate;
+        maximumBlockSize = juce::jmax(1, newMaximumBlockSize);
+        outputFormat.setChannelSet(outputLayout);
+
+        // Enough input for one block at the fastest ratio, plus the resampler's carry
+        maxInputSamples = (int)std::ceil(maximumBlockSize * maxRateRatio * (1.0 + maxRatioDeviation)) + 2;
+        laneOutput.setSize(busMaxChannels, maximumBlockSize, false, false, true);
+
+        // Tables for every common writer rate; the audio thread isn't running, so start over
+        numKernels.store(0, std::memory_order_relaxed);
+        for (auto& ratio : wantedRatios)
+            ratio.store(0.0, std::memory_order_relaxed);
+
+        for (double writerRate : { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0, sampleRate })
+            addKernel(writerRate / sampleRate);
+
+        // The counters report on this run, not whatever rate or block size came before
+        underruns.store(0, std::memory_order_relaxed);
+        staleReads.store(0, std::memory_order_relaxed);
+
+        reset();
+    }
+
+    // Designs the filter tables lanes have asked for since the last call. Message thread.
+    void updateKernels()
+    {
+        for (auto& wanted : wantedRatios)
+        {
+            const double ratio = wanted.exchange(0.0, std::memory_order_relaxed);
+
+            if (ratio > 0.0)
+                addKernel(ratio);
+        }
+    }
+
+    void reset() noexcept
+    {
+        for (auto& lane : lanes)
+            lane.reset();
+
+        currentChannelID = 0;
+    }
+
+    // How much audio we try to keep queued in every lane
+    void setTargetLatencySeconds(double seconds) noexcept
+    {
+        targetLatencySeconds = juce::jmax(0.0005, seconds);
+    }
+
+    int getTargetLatencySamples() const noexcept
+    {
+        return getTargetLatencySamples(targetLatencySeconds, sampleRate, maximumBlockSize);
+    }
+
+    // Same, for any setup: never less than one block takes at full correction (see LaneState::getTarget)
+    static int getTargetLatencySamples(double targetSeconds, double sampleRate, int maximumBlockSize) noexcept
+    {
+        return juce::jmax((int)std::ceil(maximumBlockSize * (1.0 + maxRatioDeviation)) + 2,
+                          (int)std::ceil(targetSeconds * sampleRate));
+    }
+
+    // Sums every active lane on the channel into the outputs (overwriting them), laid out
+    // as given to prepare()
+    void process(int channelID, float* const* outputs, int numOutputs, int numSamples) noexcept
+    {
+        for (int ch = 0; ch < numOutputs; ++ch)
+            juce::FloatVectorOperations::clear(outputs[ch], numSamples);
+
+        numOutputs = juce::jmin(numOutputs, outputFormat.numChannels);
+
+        auto& bus = BusShared::getInstance();
+
+        if (channelID != currentChannelID)
+        {
+            for (auto& lane : lanes)
+                lane.reset();
+
+            currentChannelID = channelID;
+            bus.clearChannel(channelID); // Start from what the senders play next, not what piled up meanwhile
+            bus.publishReaderFormat(channelID, sampleRate, maximumBlockSize, outputFormat.numChannels);
+        }
+
+        if (!bus.beginChannelRead(channelID))
+            return;
+
+        for (int offset = 0; offset < numSamples; offset += maximumBlockSize)
+        {
+            const int chunk = juce::jmin(maximumBlockSize, numSamples - offset);
+            float* chunkOutputs[busMaxChannels] = {};
+
+            for (int ch = 0; ch < numOutputs; ++ch)
+                chunkOutputs[ch] = outputs[ch] + offset;
+
+            updateAlignment(bus, channelID);
+            const bool anySoloed = isAnyLaneSoloed();
+
+            // Muted and soloed-out lanes are still rendered, so they stay lined up for when they come back
+            for (int i = 0; i < ChannelRingBuffer::maxLanes; ++i)
+            {
+                auto& lane = lanes[(size_t)i];
+
+                if (processLane(bus, channelID, i, chunk))
+                    mixLane(lane, chunkOutputs, chunk, lane.status.mix.getEffectiveGain(anySoloed));
+                else
+                    concealLane(lane, chunkOutputs, chunk); // Silent meanwhile, so it fades back in
+            }
+        }
+
+        bus.endChannelRead(channelID, numSamples);
+
+        double ratioSum = 0.0;
+        int numPlaying = 0;
+        int numActive = 0;
+        fillLow = std::numeric_limits<int>::max();
+        fillHigh = 0;
+
+        for (auto& lane : lanes)
+        {
+            if (!lane.active)
+                continue;
+
+            // Fill as it stood when the last chunk started
+            fillLow = juce::jmin(fillLow, lane.status.available);
+            fillHigh = juce::jmax(fillHigh, lane.status.available);
+            ++numActive;
+
+            if (lane.primed)
+            {
+                ratioSum += lane.ratio / lane.nominalRatio;
+                ++numPlaying;
+            }
+        }
+
+        if (numActive == 0)
+            fillLow = 0;
+
+        driftPpm.store(numPlaying > 0 ? (ratioSum / numPlaying - 1.0) * 1.0e6 : 0.0, std::memory_order_relaxed);
+    }
+
+    // Total blocks across all lanes that ran dry since prepare()
+    int getUnderruns() const noexcept { return underruns.load(std::memory_order_relaxed); }
+
+    // Chunks thrown away because the writer overwrote them while we read, since prepare()
+    int getStaleReads() const noexcept { return staleReads.load(std::memory_order_relaxed); }
+
+    // Averaged speed correction currently applied to the active lanes, in parts per million
+    double getDriftPpm() const noexcept { return driftPpm.load(std::memory_order_relaxed); }
+
+    // Telemetry for the block process() just played. Audio thread only.
+    BusReaderReport getReport() const noexcept
+    {
+        BusReaderReport report;
+        report.fillLow = fillLow;
+        report.fillHigh = fillHigh;
+        report.underruns = (uint32_t)getUnderruns();
+        report.staleReads = (uint32_t)getStaleReads();
+        report.driftPpm = (float)getDriftPpm();
+        return report;
+    }
+
+private:
+    struct LaneState
+    {
+        uint32_t generation = 0;
+        uint32_t clearEpoch = 0;
+        bool active = false;
+        BusLaneStatus status;
+        BusBlockStamp head;          // Stamp of the newest queued block
+        bool hasHead = false;
+        double desiredFill = 0.0;    // Samples this lane should hold to line up with the others
+        bool primed = false;
+        double filteredError = 0.0; // Seconds of excess (+) or missing (-) latency
+        double integral = 0.0;
+        double writerRate = 44100.0;
+        double nominalRatio = 1.0;   // Writer's rate over ours
+        double ratio = 1.0;          // Nominal ratio with the drift correction applied
+        BusResampler resampler;
+        BusChannelMatrix matrix;     // Lane layout onto ours
+        float gain = 0.0f;           // Level it last played at
+        std::array<float, busMaxChannels> lastSample{}; // Last one rendered, before the gain
+
+        void reset() noexcept
+        {
+            active = false;
+            gain = 0.0f;
+            lastSample.fill(0.0f);
+            primed = false;
+            filteredError = 0.0;
+            integral = 0.0;
+            ratio = nominalRatio;
+            resampler.reset();
+        }
+
+        // Samples the lane should hold (in its own rate) to sit at the target latency. Never less
+        // than the most one block can take at full correction plus the resampler's carry, or a
+        // lane primed at the target would run dry on its first block.
+        double getTarget(double targetSeconds, int maximumBlockSize) const noexcept
+        {
+            return juce::jmax(std::ceil(maximumBlockSize * nominalRatio * (1.0 + maxRatioDeviation)) + 2.0,
+                              targetSeconds * writerRate);
+        }
+    };
+
+    // Works out how much every active lane should hold so that they all play the same moment.
+    // A lane whose newest block was rendered later (on the timeline or the clock) than the
+    // earliest one needs that much more queued on top of the target.
+    void updateAlignment(BusShared& bus, int channelID) noexcept
+    {
+        int64_t earliestNanos = std::numeric_limits<int64_t>::max();
+
+        for (int i = 0; i < ChannelRingBuffer::maxLanes; ++i)
+        {
+            auto& lane = lanes[(size_t)i];
+
+            if (!bus.getLaneStatus(channelID, i, lane.status))
+            {
+                lane.active = false;
+                continue;
+            }
+
+            // A different stream took over the lane, or what it had queued was thrown away
+            if (!lane.active || lane.status.generation != lane.generation || lane.status.clearEpoch != lane.clearEpoch)
+            {
+                lane.writerRate = lane.status.format.isValid() ? lane.status.format.sampleRate : sampleRate;
+                lane.nominalRatio = lane.writerRate / sampleRate;
+
+                lane.resampler.setKernel(findKernel(lane.nominalRatio));
+                lane.resampler.setNumChannels(lane.status.format.numChannels);
+                lane.matrix.build(lane.status.format, outputFormat.channelTypes, outputFormat.numChannels);
+
+                lane.reset();
+                lane.active = true;
+                lane.generation = lane.status.generation;
+                lane.clearEpoch = lane.status.clearEpoch;
+            }
+
+            if (lane.nominalRatio > maxRateRatio || lane.nominalRatio < 1.0 / maxRateRatio)
+            {
+                lane.hasHead = false;
+                continue;
+            }
+
+            // An unusual rate: ask for its table and leave the lane out until updateKernels() has made it
+            if (lane.resampler.getKernel() == nullptr)
+            {
+                lane.resampler.setKernel(findKernel(lane.nominalRatio));
+
+                if (lane.resampler.getKernel() == nullptr)
+                {
+                    wantedRatios[(size_t)i].store(lane.nominalRatio, std::memory_order_relaxed);
+                    lane.hasHead = false;
+                    continue;
+                }
+            }
+
+            lane.hasHead = lane.status.available > 0
+                && bus.findLaneStamp(channelID, i, lane.status.writePos - 1, lane.head);
+
+            if (lane.hasHead)
+                earliestNanos = juce::jmin(earliestNanos, getHeadNanos(lane));
+        }
+
+        for (auto& lane : lanes)
+        {
+            if (!lane.active)
+                continue;
+
+            lane.desiredFill = lane.getTarget(targetLatencySeconds, maximumBlockSize);
+
+            if (!lane.hasHead)
+                continue;
+
+            // Lanes from one host that are playing share its timeline, which is sample-exact;
+            // line them up against the earliest of them, and that one against the clock
+            const LaneState* reference = &lane;
+
+            if (lane.head.timelineSample >= 0)
+                for (auto& other : lanes)
+                    if (other.active && other.hasHead && other.head.timelineSample >= 0
+                        && other.status.processId == lane.status.processId
+                        && getHeadTimeline(other) < getHeadTimeline(*reference))
+                        reference = &other;
+
+            lane.desiredFill += (double)(getHeadNanos(*reference) - earliestNanos) * 1.0e-9 * lane.writerRate
+                + (double)(getHeadTimeline(lane) - getHeadTimeline(*reference));
+        }
+    }
+
+    // Timeline and clock positions of the end of a lane's queued audio
+    static int64_t getHeadTimeline(const LaneState& lane) noexcept
+    {
+        return lane.head.timelineSample + (int32_t)(lane.status.writePos - lane.head.ringPos);
+    }
+
+    static int64_t getHeadNanos(const LaneState& lane) noexcept
+    {
+        return lane.head.timeNanos;
+    }
+
+    // Renders one chunk of a lane into laneOutput. Returns false if it produced nothing.
+    bool processLane(BusShared& bus, int channelID, int laneIndex, int numSamples) noexcept
+    {
+        auto& lane = lanes[(size_t)laneIndex];
+
+        if (!lane.active || lane.resampler.getKernel() == nullptr
+            || lane.nominalRatio > maxRateRatio || lane.nominalRatio < 1.0 / maxRateRatio)
+            return false;
+
+        int fill = lane.status.available;
+        const int alignmentError = fill - juce::roundToInt(lane.desiredFill);
+        const int skipLimit = (int)(juce::jmax(4.0 * maximumBlockSize, 0.1 * sampleRate) * lane.nominalRatio);
+
+        if (!lane.primed)
+        {
+            // Wait until enough is queued to start exactly at our place in the alignment
+            if (alignmentError < 0)
+                return false;
+
+            bus.consumeLane(channelID, laneIndex, alignmentError);
+            fill -= alignmentError;
+            lane.primed = true;
+        }
+        else if (alignmentError > skipLimit)
+        {
+            // Far behind (sender stalled us, we were bypassed, or a source jumped): skip ahead in one go.
+            // Smaller errors are left to the PI loop so alignment never clicks during playback.
+            bus.consumeLane(channelID, laneIndex, alignmentError);
+            fill -= alignmentError;
+            lane.filteredError = 0.0;
+            lane.integral = 0.0;
+        }
+
+        updateRatio(lane, fill - juce::roundToInt(lane.desiredFill), numSamples);
+
+        const int needed = juce::jmin(maxInputSamples, (int)std::ceil(numSamples * lane.ratio) + 2);
+
+        // Ran dry: play silence for this lane and build back up to the target
+        if (fill < needed)
+        {
+            lane.primed = false;
+            lane.resampler.reset();
+            underruns.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // The resampler reads straight out of the shared ring, wrap and all
+        BusLaneView view;
+        bus.getLaneView(channelID, laneIndex, needed, view);
+
+        const int used = lane.resampler.process(lane.ratio, view.first, view.firstLength, view.second,
+                                                laneOutput.getArrayOfWritePointers(), numSamples);
+
+        // The writer got a ring ahead and overwrote part of it as we read: drop the chunk (and
+        // the filter history built from it) and re-prime on what it's writing now
+        if (!bus.isLaneDataIntact(channelID, laneIndex, view.position))
+        {
+            lane.primed = false;
+            lane.resampler.reset();
+            staleReads.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        bus.consumeLane(channelID, laneIndex, used);
+
+        for (int ch = 0; ch < lane.resampler.getNumChannels(); ++ch)
+            lane.lastSample[(size_t)ch] = laneOutput.getSample(ch, numSamples - 1);
+
+        return true;
+    }
+
+    bool isAnyLaneSoloed() const noexcept
+    {
+        for (auto& lane : lanes)
+            if (lane.active && lane.status.mix.soloed)
+                return true;
+
+        return false;
+    }
+
+    // Sums the lane's rendered chunk into the outputs. Gain changes ramp across the chunk
+    // from the level it last played at, so moves, mutes and solos don't click.
+    void mixLane(LaneState& lane, float* const* outputs, int numSamples, float targetGain) noexcept
+    {
+        if (lane.gain != targetGain)
+        {
+            for (int ch = 0; ch < lane.resampler.getNumChannels(); ++ch)
+                laneOutput.applyGainRamp(ch, 0, numSamples, lane.gain, targetGain);
+
+            lane.matrix.addTo(laneOutput.getArrayOfReadPointers(), outputs, numSamples);
+            lane.gain = targetGain;
+        }
+        else if (targetGain != 0.0f)
+        {
+            lane.matrix.addTo(laneOutput.getArrayOfReadPointers(), outputs, numSamples, targetGain);
+        }
+    }
+
+    // A lane that was playing and produced nothing this chunk: rather than cut off, ramp from
+    // its last sample down to silence (over ~2 ms, or the chunk if that's shorter), at the
+    // level it played at. Nothing is read from the ring, so no stale audio gets in.
+    void concealLane(LaneState& lane, float* const* outputs, int numSamples) noexcept
+    {
+        if (lane.gain != 0.0f)
+        {
+            const int fadeLength = juce::jmin(numSamples, juce::jmax(1, (int)(0.002 * sampleRate)));
+
+            for (int ch = 0; ch < lane.resampler.getNumChannels(); ++ch)
+            {
+                laneOutput.clear(ch, 0, numSamples);
+                juce::FloatVectorOperations::fill(laneOutput.getWritePointer(ch), lane.lastSample[(size_t)ch], fadeLength);
+                laneOutput.applyGainRamp(ch, 0, fadeLength, lane.gain, 0.0f);
+            }
+
+            lane.matrix.addTo(laneOutput.getArrayOfReadPointers(), outputs, numSamples);
+        }
+
+        lane.gain = 0.0f;
+        lane.lastSample.fill(0.0f);
+    }
+
+    // Appends a table for the ratio unless there's one already. Message thread (or prepare()).
+    void addKernel(double ratio)
+    {
+        const int count = numKernels.load(std::memory_order_relaxed);
+
+        if (findKernel(ratio) != nullptr)
+            return;
+
+        if (count == maxKernels)
+        {
+            DBG("BusDriftReader: No room for a resampler table at ratio " << ratio);
+            return;
+        }
+
+        // Published by the count: the audio thread never looks at a table before it's complete
+        kernels[(size_t)count].design(ratio);
+        numKernels.store(count + 1, std::memory_order_release);
+    }
+
+    const BusResampler::Kernel* findKernel(double ratio) const noexcept
+    {
+        const int count = numKernels.load(std::memory_order_acquire);
+
+        for (int i = 0; i < count; ++i)
+            if (std::abs(kernels[(size_t)i].nominalRatio - ratio) <= 1.0e-9)
+                return &kernels[(size_t)i];
+
+        return nullptr;
+    }
+
+    // PI loop: excess latency speeds the lane up, a shortfall slows it down
+    void updateRatio(LaneState& lane, int errorSamples, int numSamples) noexcept
+    {
+        constexpr double proportionalGain = 0.05; // Per second of error
+        constexpr double integralGain = 0.005;    // Per second of error, per second
+
+        const double blockSeconds = numSamples / sampleRate;
+        const double error = errorSamples / lane.writerRate;
+
+        // ~1 s one-pole smoothing so block-size jitter between the two hosts doesn't wobble the pitch
+        lane.filteredError += (error - lane.filteredError) * juce::jmin(1.0, blockSeconds);
+        lane.integral = juce::jlimit(-maxRatioDeviation, maxRatioDeviation,
+            lane.integral + integralGain * lane.filteredError * blockSeconds);
+
+        lane.ratio = lane.nominalRatio * (1.0 + juce::jlimit(-maxRatioDeviation, maxRatioDeviation,
+            proportionalGain * lane.filteredError + lane.integral));
+    }
+
+    std::array<LaneState, ChannelRingBuffer::maxLanes> lanes;
+
+    // Resampler tables, only ever appended to between prepare() calls, so lanes can keep
+    // pointing into it; and the ratios lanes are waiting for a table for (0 = none)
+    static constexpr int maxKernels = 32;
+    std::array<BusResampler::Kernel, maxKernels> kernels;
+    std::atomic<int> numKernels{ 0 };
+    std::array<std::atomic<double>, ChannelRingBuffer::maxLanes> wantedRatios{};
+    juce::AudioBuffer<float> laneOutput;
+
+    BusStreamFormat outputFormat; // Our layout; only the channel types and count are used
+
+    double sampleRate = 44100.0;
+    double targetLatencySeconds = 0.02;
+    int maximumBlockSize = 512;
+    int maxInputSamples = 0;
+    int currentChannelID = 0;
+    int fillLow = 0, fillHigh = 0; // Lane fill range of the last process() call
+
+    std::atomic<int> underruns{ 0 };
+    std::atomic<int> staleReads{ 0 };
+    std::atomic<double> driftPpm{ 0.0 };
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+
+// Safety limiter for the bus output, so a sum of hot sources can't clip the host.
+// One gain for all channels, so the image doesn't shift. The attack is instant (the gain
+// drops to exactly ceiling / peak on the sample that would exceed it) and the release is
+// exponential; there's no look-ahead, hence no latency to report. Blocks that stay under
+// the ceiling with the gain fully recovered cost one peak scan per channel.
+class BusLimiter
+{
+public:
+    void prepare(double sampleRate, int maximumBlockSize)
+    {
+        peak.setSize(2, juce::jmax(1, maximumBlockSize), false, false, true);
+        releaseCoefficient = (float)std::exp(-1.0 / (releaseSeconds * sampleRate));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        gain = 1.0f;
+        gainReductionDb.store(0.0f, std::memory_order_relaxed);
+    }
+
+    void setCeilingDecibels(float ceilingDb) noexcept
+    {
+        ceiling = juce::Decibels::decibelsToGain(ceilingDb);
+    }
+
+    void process(float* const* channels, int numChannels, int numSamples) noexcept
+    {
+        if (numChannels <= 0 || numSamples <= 0)
+            return;
+
+        float lowestGain = gain;
+
+        for (int offset = 0; offset < numSamples; offset += peak.getNumSamples())
+        {
+            const int chunk = juce::jmin(peak.getNumSamples(), numSamples - offset);
+            lowestGain = juce::jmin(lowestGain, processChunk(channels, numChannels, offset, chunk));
+        }
+
+        gainReductionDb.store(juce::Decibels::gainToDecibels(lowestGain, -60.0f), std::memory_order_relaxed);
+    }
+
+    // Deepest reduction in the last block, in dB (0 or negative). Safe from any thread.
+    float getGainReductionDecibels() const noexcept { return gainReductionDb.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr double releaseSeconds = 0.08;
+
+    // Returns the lowest gain applied
+    float processChunk(float* const* channels, int numChannels, int offset, int numSamples) noexcept
+    {
+        float* envelope = peak.getWritePointer(0);
+        float* scratch = peak.getWritePointer(1);
+
+        // Loudest channel at every sample
+        juce::FloatVectorOperations::abs(envelope, channels[0] + offset, numSamples);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+        {
+            juce::FloatVectorOperations::abs(scratch, channels[ch] + offset, numSamples);
+            juce::FloatVectorOperations::max(envelope, envelope, scratch, numSamples);
+        }
+
+        if (gain == 1.0f && juce::FloatVectorOperations::findMaximum(envelope, numSamples) <= ceiling)
+            return 1.0f;
+
+        // The gain curve is recursive, so this part stays scalar; applying it is vectorised
+        float lowestGain = gain;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float limit = envelope[i] > ceiling ? ceiling / envelope[i] : 1.0f;
+            gain = limit < gain ? limit : limit + (gain - limit) * releaseCoefficient;
+            lowestGain = juce::jmin(lowestGain, gain);
+            envelope[i] = gain;
+        }
+
+        // Snap the tail of a release, so settled blocks take the fast path again
+        if (gain > 0.9999f)
+            gain = 1.0f;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::multiply(channels[ch] + offset, envelope, numSamples);
+
+        return lowestGain;
+    }
+
+    juce::AudioBuffer<float> peak; // Envelope, then gain curve; and a scratch row
+    float ceiling = 1.0f;
+    float gain = 1.0f;
+    float releaseCoefficient = 0.0f;
+    std::atomic<float> gainReductionDb{ 0.0f };
+};
@@ -0,0 +1,176 @@
+#pragma once
+#include <JuceHeader.h>
+#include <limits>
+#include <vector>
+
+// Variable-ratio polyphase FIR resampler for one bus lane (up to maxChannels wide).
+// The kernel is a Kaiser-windowed sinc tabulated at numPhases fractional offsets
+// (outputs between two phases blend the neighbouring dot products). Its cutoff sits
+// below the lower of the two Nyquist frequencies, so converting down doesn't alias.
+// Like juce::WindowedSincInterpolator, process() pulls input as it needs it and
+// returns how much it used; the ratio is input samples per output sample.
+// The tables (Kernel) are designed ahead of time and shared, see BusDriftReader.
+class BusResampler
+{
+public:
+    static constexpr int numTaps = 64;    // Per phase; ~80 dB stop band, ~0.08 fs transition
+    static constexpr int numPhases = 128; // Fractional positions tabulated between two inputs
+    static constexpr int maxChannels = 16;
+
+    // Filter table for converting at around one ratio. Only the cutoff depends on it, so small
+    // drift corrections on top need no redesign. Designing one allocates and takes a while, so
+    // it's never done on the audio thread.
+    struct Kernel
+    {
+        double nominalRatio = 0.0;
+        std::vector<float> coefficients; // (numPhases + 1) phases of numTaps, oldest tap first
+
+        void design(double newRatio)
+        {
+            nominalRatio = newRatio;
+            coefficients.resize((size_t)(numPhases + 1) * numTaps);
+
+            // Band edge (in cycles per input sample) just under the lower Nyquist
+            const double cutoff = 0.5 * juce::jmin(1.0, 1.0 / newRatio) * 0.92;
+            const double beta = 8.0;
+            const double windowNorm = 1.0 / besselI0(beta);
+            const double centre = numTaps / 2 - 1;
+
+            for (int phase = 0; phase <= numPhases; ++phase)
+            {
+                float* c = coefficients.data() + (size_t)phase * numTaps;
+                const double offset = centre + (double)phase / numPhases;
+                double sum = 0.0;
+
+                for (int k = 0; k < numTaps; ++k)
+                {
+                    const double t = k - offset;
+                    const double x = t / (numTaps / 2);
+                    const double window = std::abs(x) < 1.0 ? besselI0(beta * std::sqrt(1.0 - x * x)) * windowNorm : 0.0;
+                    const double arg = juce::MathConstants<double>::twoPi * cutoff * t;
+                    const double sinc = std::abs(arg) < 1.0e-9 ? 1.0 : std::sin(arg) / arg;
+                    c[k] = (float)(2.0 * cutoff * sinc * window);
+                    sum += c[k];
+                }
+
+                // Unity gain at DC for every phase, so the output doesn't ripple with position
+                for (int k = 0; k < numTaps; ++k)
+                    c[k] = (float)(c[k] / sum);
+            }
+        }
+    };
+
+    // Table to convert with (null = none, process() mustn't be called). It has to outlive
+    // its use here. Cheap enough for the audio thread.
+    void setKernel(const Kernel* newKernel) noexcept { kernel = newKernel; }
+    const Kernel* getKernel() const noexcept { return kernel; }
+
+    // Channels process() reads and writes; follow with reset()
+    void setNumChannels(int newNumChannels) noexcept
+    {
+        numChannels = juce::jlimit(1, maxChannels, newNumChannels);
+    }
+
+    int getNumChannels() const noexcept { return numChannels; }
+
+    void reset() noexcept
+    {
+        for (auto& h : history)
+            std::fill(std::begin(h), std::end(h), 0.0f);
+
+        writeIndex = 0;
+        position = 1.0;
+    }
+
+    // Input samples between a sample entering and it reaching the output
+    static constexpr double getBaseLatency() noexcept { return numTaps / 2; }
+
+    // Renders numOutput samples per channel, reading input as needed. Returns input samples used.
+    int process(double ratio, const float* const* input, float* const* output, int numOutput) noexcept
+    {
+        return process(ratio, input, std::numeric_limits<int>::max(), nullptr, output, numOutput);
+    }
+
+    // Same, with the input in two parts: inputLength samples in input, then the rest in
+    // wrapped. Lets the reader run straight off a ring buffer that wraps mid-block.
+    int process(double ratio, const float* const* input, int inputLength, const float* const* wrapped,
+                float* const* output, int numOutput) noexcept
+    {
+        int used = 0;
+        int partStart = 0;
+
+        for (int i = 0; i < numOutput; ++i)
+        {
+            while (position >= 1.0)
+            {
+                if (used - partStart == inputLength)
+                {
+                    input = wrapped;
+                    inputLength = std::numeric_limits<int>::max();
+                    partStart = used;
+                }
+
+                push(input, used++ - partStart);
+                position -= 1.0;
+            }
+
+            const double phasePosition = position * numPhases;
+            const int phase = juce::jmin(numPhases - 1, (int)phasePosition);
+            const float blend = (float)(phasePosition - phase);
+            const float* c0 = getPhase(phase);
+            const float* c1 = c0 + numTaps;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                // History is stored twice over so the newest numTaps inputs are always contiguous
+                const float* h = history[ch] + writeIndex;
+                float y0 = 0.0f, y1 = 0.0f;
+
+                for (int k = 0; k < numTaps; ++k)
+                {
+                    y0 += h[k] * c0[k];
+                    y1 += h[k] * c1[k];
+                }
+
+                output[ch][i] = y0 + blend * (y1 - y0);
+            }
+
+            position += ratio;
+        }
+
+        return used;
+    }
+
+private:
+    void push(const float* const* input, int index) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            history[ch][writeIndex] = input[ch][index];
+            history[ch][writeIndex + numTaps] = input[ch][index];
+        }
+
+        writeIndex = (writeIndex + 1) % numTaps;
+    }
+
+    const float* getPhase(int phase) const noexcept { return kernel->coefficients.data() + (size_t)phase * numTaps; }
+
+    static double besselI0(double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 32 && term > sum * 1.0e-12; ++k)
+        {
+            term *= (x * 0.5 / k) * (x * 0.5 / k);
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    const Kernel* kernel = nullptr;
+    float history[maxChannels][2 * numTaps] = {};
+    int numChannels = 2;
+    int writeIndex = 0;                   // Oldest sample of the window
+    double position = 1.0;                // Fraction of an input past the newest sample
+};
@@ -1,30 +1,461 @@
 #pragma once
 #include <JuceHeader.h>
+#include "BusSharedPlatform.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
-#if JUCE_WINDOWS
-#include <windows.h>
+// Size of the ring pool reserved in shared memory. Only rings that are in use are
+// committed, so this is address space rather than RAM.
+#ifndef BUSALPHA5_POOL_MEGABYTES
+#define BUSALPHA5_POOL_MEGABYTES 256
 #endif
 
-// Per-channel ring buffer for mixing
-struct ChannelRingBuffer
+// Longest a source can run ahead of the bus before its oldest audio is overwritten
+#ifndef BUSALPHA5_MAX_LATENCY_MS
+#define BUSALPHA5_MAX_LATENCY_MS 500
+#endif
+
+// How long a writer may go without a heartbeat before readers leave it out of the sum
+// (stretched to four of its blocks for hosts with very large buffers)
+#ifndef BUSALPHA5_STALL_MS
+#define BUSALPHA5_STALL_MS 100
+#endif
+
+// Channel IDs in the segment. 1-32 are the numbered channels the plugins offer; the rest
+// are handed out to named channels ("drums/kick") by the directory. Each one costs a few KB
+// of control words; rings are only allocated for lanes that are actually sending.
+#ifndef BUSALPHA5_MAX_CHANNELS
+#define BUSALPHA5_MAX_CHANNELS 256
+#endif
+
+// Written by the sender alongside every block: where the block sits on its host's
+// timeline and when it was rendered. Kept in a small ring right after the lane's samples.
+struct BusBlockStamp
+{
+    static constexpr int ringSize = 64; // Blocks of history kept per lane
+
+    uint32_t ringPos = 0;        // Lane position of the block's first sample
+    int32_t numSamples = 0;
+    uint32_t sequence = 0;       // Writer's block number, one up per block; a slot holding another number was reused
+    int64_t timelineSample = -1; // Host play head position of the first sample, -1 when stopped/unknown
+    int64_t timeNanos = 0;       // Monotonic clock (shared by all processes) when the block was sent, less any route latency
+    double sampleRate = 0.0;
+};
+
+// Most audio channels one lane carries: 7.1.4 and 9.1.6 fit, as do 16 discrete channels
+static constexpr int busMaxChannels = 16;
+
+// Audio format one side of a channel runs at. Writers publish theirs per lane, readers
+// per channel, so each side can tell when the other needs converting.
+struct BusStreamFormat
+{
+    double sampleRate = 0.0; // 0 until published
+    int maximumBlockSize = 0;
+    int numChannels = 0;
+    uint16_t channelTypes[busMaxChannels] = {}; // juce::AudioChannelSet::ChannelType of each channel; writers only
+
+    bool isValid() const noexcept { return sampleRate > 0.0; }
+
+    // Takes the speaker layout of a host bus. A disabled bus counts as mono.
+    void setChannelSet(const juce::AudioChannelSet& channelSet) noexcept
+    {
+        numChannels = juce::jlimit(1, busMaxChannels, channelSet.size());
+
+        for (int i = 0; i < busMaxChannels; ++i)
+            channelTypes[i] = (uint16_t)(i < channelSet.size() ? channelSet.getTypeOfChannel(i)
+                                                               : i == 0 ? juce::AudioChannelSet::centre
+                                                                        : juce::AudioChannelSet::discreteChannel0 + i);
+    }
+
+    bool hasSameLayout(const BusStreamFormat& other) const noexcept
+    {
+        return numChannels == other.numChannels
+            && std::memcmp(channelTypes, other.channelTypes, sizeof(channelTypes)) == 0;
+    }
+};
+
+// Producer-owned and consumer-owned words live on separate lines so a store on one side
+// never invalidates the line the other side is polling. 128 bytes also covers the
+// adjacent-line prefetcher on x86 and the native line size on Apple silicon.
+static constexpr size_t busCacheLineSize = 128;
+
+static constexpr int busNumberedChannels = 32;
+static constexpr int busMaxChannelIDs = BUSALPHA5_MAX_CHANNELS;
+static_assert(busMaxChannelIDs >= busNumberedChannels, "The numbered channels must fit");
+
+// How long one side of a channel (a writer's or a reader's processBlock) takes per block,
+// and when it last ran. Only the owning side stores into it, once per block, with plain
+// loads and stores; editors and monitors in any process just load. Peaks cover the last
+// full second plus the current one, so a spike stays visible for at least a second.
+struct BusBlockTiming
+{
+    static constexpr int64_t windowNanos = 1000000000;
+
+    std::atomic<int64_t> heartbeatNanos{ 0 };  // getMonotonicNanos() when the last block finished, 0 if never
+    std::atomic<uint32_t> blockNanos{ 0 };     // Time the last block took
+    std::atomic<uint32_t> peakBlockNanos{ 0 }; // Longest block in the window
+    std::atomic<uint32_t> budgetNanos{ 0 };    // Audio time the last block covered, i.e. its deadline
+
+    // Owner's bookkeeping for the peak window
+    uint32_t windowPeak = 0;
+    uint32_t previousWindowPeak = 0;
+    int64_t windowStart = 0;
+
+    // Only while nobody else owns the side, e.g. when a lane is claimed
+    void reset() noexcept
+    {
+        heartbeatNanos.store(0, std::memory_order_relaxed);
+        blockNanos.store(0, std::memory_order_relaxed);
+        peakBlockNanos.store(0, std::memory_order_relaxed);
+        budgetNanos.store(0, std::memory_order_relaxed);
+        windowPeak = previousWindowPeak = 0;
+        windowStart = 0;
+    }
+
+    void publish(int64_t startNanos, int64_t endNanos, int numSamples, double sampleRate) noexcept
+    {
+        const auto elapsed = (uint32_t)juce::jlimit((int64_t)0, (int64_t)0xffffffff, endNanos - startNanos);
+
+        if (endNanos - windowStart >= windowNanos)
+        {
+            previousWindowPeak = windowPeak;
+            windowPeak = 0;
+            windowStart = endNanos;
+        }
+
+        windowPeak = juce::jmax(windowPeak, elapsed);
+
+        blockNanos.store(elapsed, std::memory_order_relaxed);
+        peakBlockNanos.store(juce::jmax(windowPeak, previousWindowPeak), std::memory_order_relaxed);
+        budgetNanos.store(sampleRate > 0.0 ? (uint32_t)(numSamples * 1.0e9 / sampleRate) : 0, std::memory_order_relaxed);
+        heartbeatNanos.store(endNanos, std::memory_order_release);
+    }
+};
+
+// What a reader reports about the block it just played
+struct BusReaderReport
+{
+    int fillLow = 0;        // Emptiest and fullest active lane at the start of the block
+    int fillHigh = 0;
+    uint32_t underruns = 0;  // Since the reader was prepared
+    uint32_t staleReads = 0; // Reads thrown away because the writer overwrote them meanwhile, since prepared
+    float driftPpm = 0.0f;   // Speed correction it applies to its sources
+};
+
+// Reader-side health of a channel, published by the reader every block. With several
+// readers on one channel the last one to publish wins, as with the reader format.
+struct BusReaderTelemetry
+{
+    BusBlockTiming timing;
+    std::atomic<int> fillLow{ 0 };  // Lane fill watermarks (samples) over the same window as the timing peak
+    std::atomic<int> fillHigh{ 0 };
+    std::atomic<uint32_t> underruns{ 0 };
+    std::atomic<uint32_t> staleReads{ 0 };
+    std::atomic<float> driftPpm{ 0.0f };
+
+    // Reader's bookkeeping for the watermark window
+    int windowLow = 0, windowHigh = 0;
+    int previousWindowLow = 0, previousWindowHigh = 0;
+    int64_t windowStart = 0;
+
+    void publish(int64_t startNanos, int64_t endNanos, int numSamples, double sampleRate, const BusReaderReport& report) noexcept
+    {
+        if (endNanos - windowStart >= BusBlockTiming::windowNanos)
+        {
+            previousWindowLow = windowStart != 0 ? windowLow : report.fillLow;
+            previousWindowHigh = windowStart != 0 ? windowHigh : report.fillHigh;
+            windowLow = report.fillLow;
+            windowHigh = report.fillHigh;
+            windowStart = endNanos;
+        }
+
+        windowLow = juce::jmin(windowLow, report.fillLow);
+        windowHigh = juce::jmax(windowHigh, report.fillHigh);
+
+        fillLow.store(juce::jmin(windowLow, previousWindowLow), std::memory_order_relaxed);
+        fillHigh.store(juce::jmax(windowHigh, previousWindowHigh), std::memory_order_relaxed);
+        underruns.store(report.underruns, std::memory_order_relaxed);
+        staleReads.store(report.staleReads, std::memory_order_relaxed);
+        driftPpm.store(report.driftPpm, std::memory_order_relaxed);
+        timing.publish(startNanos, endNanos, numSamples, sampleRate);
+    }
+};
+
+// A source's settings on the bus mixer, published by its writer (see setLaneMix)
+struct BusLaneMix
+{
+    float gain = 1.0f;   // Linear send level, applied by the reader
+    bool muted = false;
+    bool soloed = false; // Solo in place: while any lane on the channel is soloed, only soloed lanes play
+
+    // Gain the lane plays at, given whether anything on its channel is soloed
+    float getEffectiveGain(bool anySoloed) const noexcept
+    {
+        return muted || (anySoloed && !soloed) ? 0.0f : gain;
+    }
+};
+
+// One producer lane inside a channel. Every Channel Alpha instance that sends to
+// a channel claims its own lane, so writers never share a write position.
+// The samples live in the pool; the lane only records where.
+struct SourceLane
 {
-    static constexpr int bufferSizeSamples = 262144; // ~5.5 seconds at 48kHz
+    enum State
+    {
+        laneFree = 0,    // Nobody owns it
+        laneClaimed = 1, // Owned, but no ring yet (or being resized) - readers skip it
+        laneActive = 2,  // Owned with a ring, readers sum it
+        laneReaping = 3  // Its owner died and another process is freeing it
+    };
 
-    std::atomic<int> writePos{ 0 };
-    std::atomic<int> readPos{ 0 };
-    float leftChannel[bufferSizeSamples];
-    float rightChannel[bufferSizeSamples];
-    std::atomic<int> activeWriters{ 0 }; // Count of Channel Alpha instances writing
+    // Read-mostly: only changes when the lane is claimed, prepared or released. Together
+    // with the writer's heartbeat (writerTiming) this is the bus's table of writers.
+    alignas(busCacheLineSize) std::atomic<int> state{ laneFree };
+    uint64_t ringOffset = 0;             // Byte offset of the ring in the pool
+    int capacity = 0;                    // Samples per channel, power of two
+    uint32_t generation = 0;             // Bumped every time the lane gets a fresh ring
+    BusStreamFormat format;              // Writer's host format, set by prepareWriter
+    uint32_t processId = 0;              // Owner's process; timelines only compare within one host
+    std::atomic<uint64_t> instanceId{ 0 }; // Owner's registration, unique within the segment
+    int64_t stallNanos = 0;              // Heartbeat age at which readers drop the lane from the sum
+    std::atomic<float> mixGain{ 1.0f };  // BusLaneMix; only stored when the writer changes it
+    std::atomic<uint32_t> mixFlags{ 0 };
+    std::atomic<uint32_t> clearEpoch{ 0 }; // Bumping it turns everything queued into silence, see clearChannel()
+    std::atomic<uint32_t> idleWritePos{ 0 }; // releaseIdleRings() bookkeeping
+    std::atomic<uint32_t> idleScans{ 0 };
+
+    // Producer line
+    alignas(busCacheLineSize) std::atomic<uint32_t> writePos{ 0 }; // Free-running
+    std::atomic<uint32_t> writeReserve{ 0 }; // End of the block being written, stored before its samples (see isLaneDataIntact)
+    uint32_t writerCachedReadPos = 0;    // Writer's last look at readPos
     std::atomic<int64_t> totalWritten{ 0 };
+    std::atomic<uint32_t> overruns{ 0 }; // Blocks written over audio the reader hadn't consumed
+    std::atomic<uint32_t> blockCount{ 0 }; // Stamps written; the newest is at (blockCount - 1) % ringSize
+    std::atomic<int> writerInside{ 0 };  // Owner is writing into the ring; freeLaneRing() waits for it
+    BusBlockTiming writerTiming;         // The writer's processBlock, see publishWriterTiming()
+
+    // Consumer line
+    alignas(busCacheLineSize) std::atomic<uint32_t> readPos{ 0 };  // Free-running
+    uint32_t readerCachedWritePos = 0;   // Reader's last look at writePos
+    uint32_t readerClearEpoch = 0;       // clearEpoch the reader last acted on
+};
+
+static_assert(sizeof(SourceLane) == 3 * busCacheLineSize, "SourceLane control words must stay on their own lines");
+
+// Per-channel set of source lanes, summed by the reader
+struct ChannelRingBuffer
+{
+    static constexpr int maxLanes = 16; // Channel Alpha instances per channel
+
+    SourceLane lanes[maxLanes];
+
+    // Reader line
+    alignas(busCacheLineSize) std::atomic<int> readersInside{ 0 }; // Readers currently touching lane rings
     std::atomic<int64_t> totalRead{ 0 };
+    std::atomic<double> readerSampleRate{ 0.0 }; // Last reader to publish wins; 0 when nobody has
+    std::atomic<int> readerBlockSize{ 0 };
+    std::atomic<int> readerNumChannels{ 0 };
+
+    // Published by the reader once per block
+    alignas(busCacheLineSize) BusReaderTelemetry readerTelemetry;
+};
+
+// Bitmap allocator for the ring pool. Only used off the audio thread.
+struct BusPoolDirectory
+{
+    static constexpr size_t granuleBytes = 64 * 1024;
+    static constexpr size_t poolBytes = (size_t)BUSALPHA5_POOL_MEGABYTES * 1024 * 1024;
+    static constexpr int numGranules = (int)(poolBytes / granuleBytes);
+
+    std::atomic<uint32_t> lockOwner{ 0 }; // Process ID holding the lock, 0 when free
+    std::atomic<uint64_t> bytesInUse{ 0 };
+    uint64_t usedGranules[(numGranules + 63) / 64];
+};
+
+// One hop of the routing graph: a Bus Alpha instance re-publishing the mix it reads on
+// one channel onto another, e.g. a sub-group feeding the master
+struct BusRoute
+{
+    int fromChannel = 0;         // 0 when the slot is free
+    int toChannel = 0;
+    float latencySeconds = 0.0f; // Delay the hop adds, i.e. how far behind its senders the reading bus plays
+    uint32_t processId = 0;      // Owner's process, so routes of crashed hosts can be dropped
+};
+
+// Bus-to-bus routes of the whole segment. Edited off the audio thread under its own
+// cross-process lock, where any edit that would close a loop is refused; the per-channel
+// figures below are rebuilt after every edit and can be read from any thread.
+struct BusRouteTable
+{
+    static constexpr int maxRoutes = 64;
+
+    std::atomic<uint32_t> lockOwner{ 0 }; // Process ID holding the lock, 0 when free
+    std::atomic<uint32_t> version{ 0 };   // Bumped on every edit
+    BusRoute routes[maxRoutes];
+
+    std::atomic<int> depth[busMaxChannelIDs];         // Hops on the longest route path into the channel, 0 if nothing feeds it
+    std::atomic<float> pathLatency[busMaxChannelIDs]; // Seconds its routed audio already lags the original senders (slowest path)
+};
+
+// A name in the channel directory and the channel ID it was given
+struct BusChannelName
+{
+    static constexpr int maxLength = 63;
+
+    uint32_t hash = 0;       // Of the name; 0 marks an empty slot
+    int channelID = 0;
+    int64_t lastUsedNanos = 0; // Refreshed by every lookup that uses it
+    char name[maxLength + 1] = {};
+};
+
+// Hash table from channel names to channel IDs above the numbered ones, open addressing
+// with linear probing (and backward-shift deletion, so no tombstones pile up). Only used
+// off the audio thread, under its own cross-process lock; plugins look their name up once
+// and keep the ID.
+struct BusChannelDirectory
+{
+    static constexpr int numSlots = 2 * busMaxChannelIDs; // At most half full
+    static constexpr int64_t leaseNanos = 10000000000LL;  // How long a name outlives its last user
+
+    std::atomic<uint32_t> lockOwner{ 0 }; // Process ID holding the lock, 0 when free
+    BusChannelName slots[numSlots];
+    int slotOfChannel[busMaxChannelIDs]; // Slot + 1 of the name holding each channel ID, 0 if none
+};
+
+// Identifies the layout at the start of the segment so mismatched builds refuse to attach
+struct BusSharedHeader
+{
+    static constexpr uint32_t magicValue = 0x42555335; // "BUS5"
+    static constexpr uint32_t layoutVersion = 16;
+
+    std::atomic<uint32_t> magic{ 0 }; // Published last by the creating process
+    uint32_t version = 0;
+    uint64_t segmentSize = 0;
+    uint64_t poolOffset = 0;
+    std::atomic<int> attachedProcesses{ 0 };
+    std::atomic<uint64_t> nextInstanceId{ 1 }; // Hands out SourceLane::instanceId
+    BusPoolDirectory pool;
 };
 
-// Shared memory structure for all 32 channels
+// Control region at the start of the segment. The ring pool follows it.
 struct BusSharedMemory
 {
-    ChannelRingBuffer channels[32]; // Channels 1-32 (index 0-31)
+    BusSharedHeader header;
+    ChannelRingBuffer channels[busMaxChannelIDs]; // Channel IDs 1 and up (index 0 and up)
+    BusRouteTable routes;
+    BusChannelDirectory directory;
+};
+
+// What a reader needs to know about a lane before pulling from it
+struct BusLaneStatus
+{
+    int available = 0;       // Samples queued
+    uint32_t generation = 0; // Changes whenever the lane's ring is replaced, i.e. a different stream starts
+    uint32_t readPos = 0;
+    uint32_t writePos = 0;
+    BusStreamFormat format;
+    uint32_t processId = 0;
+    BusLaneMix mix;
+    uint32_t clearEpoch = 0; // Changes when the lane's queued audio was thrown away (clearChannel)
+};
+
+// Read-only view of the oldest audio queued in a lane, in place in the shared ring, so a
+// reader can process straight out of shared memory instead of copying first. Where the
+// block wraps around the end of the ring it comes in two parts; secondLength is 0 otherwise.
+// Valid until the lane is consumed or the channel read ends (see BusShared::getLaneView).
+struct BusLaneView
+{
+    const float* first[busMaxChannels] = {};
+    const float* second[busMaxChannels] = {};
+    uint32_t position = 0; // Lane position of the first sample, for BusShared::isLaneDataIntact()
+    int firstLength = 0;
+    int secondLength = 0;
+    int numChannels = 0;
+
+#if JUCE_MODULE_AVAILABLE_juce_dsp
+    juce::dsp::AudioBlock<const float> getFirstBlock() const noexcept
+    {
+        return juce::dsp::AudioBlock<const float>(first, (size_t)numChannels, (size_t)firstLength);
+    }
+
+    juce::dsp::AudioBlock<const float> getSecondBlock() const noexcept
+    {
+        return juce::dsp::AudioBlock<const float>(second, (size_t)numChannels, (size_t)secondLength);
+    }
+#endif
+};
+
+// Copy of a BusBlockTiming, for display
+struct BusTimingSnapshot
+{
+    int64_t heartbeatNanos = 0; // 0 if the side never reported
+    uint32_t blockNanos = 0;
+    uint32_t peakBlockNanos = 0;
+    uint32_t budgetNanos = 0;
+
+    // Share of the real-time budget spent on the last block (1 = missed its deadline)
+    double getLoad() const noexcept { return budgetNanos > 0 ? (double)blockNanos / budgetNanos : 0.0; }
+    double getPeakLoad() const noexcept { return budgetNanos > 0 ? (double)peakBlockNanos / budgetNanos : 0.0; }
+
+    // Seconds since the side last ran, or -1 if it never did
+    double getSecondsSinceHeartbeat(int64_t nowNanos) const noexcept
+    {
+        return heartbeatNanos != 0 ? (double)(nowNanos - heartbeatNanos) * 1.0e-9 : -1.0;
+    }
+};
+
+// Health of one lane as seen from outside
+struct BusLaneHealth
+{
+    bool active = false;
+    bool stalled = false; // Active, but its writer stopped calling in and it's left out of the sum
+    uint32_t processId = 0;
+    uint64_t instanceId = 0;
+    BusStreamFormat format;
+    BusLaneMix mix;
+    int fill = 0; // Samples queued
+    int capacity = 0;
+    uint32_t overruns = 0;
+    int64_t totalWritten = 0;
+    BusTimingSnapshot writer;
+};
+
+// Everything the shared segment knows about a channel's health, gathered in one call for
+// editors and the BusMonitor tool. Lock-free and allocation-free, but not real-time cheap.
+struct BusChannelHealth
+{
+    int activeWriters = 0; // Lanes whose writer is calling in, as getActiveWriters()
+    BusLaneHealth lanes[ChannelRingBuffer::maxLanes];
+    BusStreamFormat readerFormat;
+    BusTimingSnapshot reader;
+    int fillLow = 0, fillHigh = 0;
+    uint32_t underruns = 0;
+    uint32_t staleReads = 0;
+    float driftPpm = 0.0f;
+    int64_t totalRead = 0;
+
+    uint32_t getOverruns() const noexcept
+    {
+        uint32_t total = 0;
+        for (auto& lane : lanes)
+            total += lane.overruns;
+        return total;
+    }
+};
+
+// The lane a Channel Alpha instance owns on a channel
+struct BusWriterHandle
+{
+    int16_t channelID = 0;
+    int16_t lane = -1;
+    uint32_t instance = 0; // Low half of the lane's instanceId when claimed; a lane claimed again since doesn't match
+
+    bool isValid() const noexcept { return lane >= 0; }
 };
 
+static_assert(sizeof(BusWriterHandle) == 8, "Owners keep their handle in a lock-free std::atomic");
+
 class BusShared
 {
 public:
@@ -36,209 +467,1532 @@ public:
 
     bool isInitialized() const { return sharedBuffer != nullptr; }
 
-    // Called by Channel Alpha 5 to write to a specific channel
-    void writeToChannel(int channelID, const float* left, const float* right, int numSamples) noexcept
+    // Stereo convenience for writeToChannel(); a null right repeats the left
+    void writeToChannel(BusWriterHandle writer, const float* left, const float* right, int numSamples,
+                        int64_t timelineSample = -1) noexcept
+    {
+        const float* channels[2] = { left, right != nullptr ? right : left };
+        writeToChannel(writer, channels, 2, numSamples, timelineSample);
+    }
+
+    // Called by Channel Alpha 5 to write into the lane it owns, one pointer per channel of the
+    // layout given to prepareWriter(). Lane channels beyond numChannels (or with a null
+    // pointer) carry silence. timelineSample is the host play head position of the block's
+    // first sample, or -1 when the transport isn't running. A bus re-publishing what it read
+    // (see addRoute()) passes how long ago its audio left the original senders as
+    // latencySeconds; the block is stamped that much earlier, so readers hold direct
+    // senders back by the same amount and every hop adds a fixed delay.
+    void writeToChannel(BusWriterHandle writer, const float* const* channels, int numChannels, int numSamples,
+                        int64_t timelineSample = -1, double latencySeconds = 0.0) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return;
+        if (!sharedBuffer || !writer.isValid() || writer.channelID < 1 || writer.channelID > busMaxChannelIDs) return;
+
+        auto& lane = sharedBuffer->channels[writer.channelID - 1].lanes[writer.lane];
 
-        int channelIndex = channelID - 1;
-        auto& channel = sharedBuffer->channels[channelIndex];
+        // Check in before looking at the lane, so a ring that's being freed (unregisterWriter()
+        // from another thread) waits until we're out of it rather than being handed on mid-block
+        lane.writerInside.store(1, std::memory_order_seq_cst);
+
+        // Not prepared yet, the block is bigger than the ring, or the lane is no longer ours
+        if (lane.state.load(std::memory_order_seq_cst) != SourceLane::laneActive || !isOwnedBy(lane, writer)
+            || numSamples > lane.capacity)
+        {
+            lane.writerInside.store(0, std::memory_order_release);
+            return;
+        }
 
-        const int mask = ChannelRingBuffer::bufferSizeSamples - 1;
-        int writeIndex = channel.writePos.load(std::memory_order_acquire);
+        const uint32_t writeIndex = lane.writePos.load(std::memory_order_relaxed);
 
-        // Direct write (like Loopback - no clearing needed)
-        for (int i = 0; i < numSamples; ++i)
+        // Only look at the reader's line when our cached copy says we might be overrunning it
+        if (writeIndex + (uint32_t)numSamples - lane.writerCachedReadPos > (uint32_t)lane.capacity)
         {
-            int idx = (writeIndex + i) & mask;
+            lane.writerCachedReadPos = lane.readPos.load(std::memory_order_acquire);
+
+            if (writeIndex + (uint32_t)numSamples - lane.writerCachedReadPos > (uint32_t)lane.capacity)
+                lane.overruns.fetch_add(1, std::memory_order_relaxed);
+        }
 
-            float leftSample = left[i];
-            float rightSample = right ? right[i] : left[i];
+        // Announce how far we're about to write before touching any sample, so a reader still
+        // working on what we overwrite can tell afterwards (isLaneDataIntact)
+        lane.writeReserve.store(writeIndex + (uint32_t)numSamples, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
 
-            channel.leftChannel[idx] = leftSample;
-            channel.rightChannel[idx] = rightSample;
+        // Only this writer touches the lane, so no clearing or summing is needed here
+        const RingSpans spans(writeIndex, numSamples, lane.capacity);
+
+        for (int ch = 0; ch < lane.format.numChannels; ++ch)
+        {
+            const float* source = ch < numChannels ? channels[ch] : nullptr;
+            float* ring = getRing(lane, ch);
+
+            if (source != nullptr)
+            {
+                copyToRing(ring, spans, source);
+            }
+            else
+            {
+                juce::FloatVectorOperations::clear(ring + spans.start, spans.first);
+                if (spans.second > 0)
+                    juce::FloatVectorOperations::clear(ring, spans.second);
+            }
         }
 
-        channel.writePos.store((writeIndex + numSamples) & mask, std::memory_order_release);
-        channel.totalWritten.fetch_add(numSamples, std::memory_order_relaxed);
+        // The stamp is published together with the samples by the writePos release below
+        const uint32_t blockIndex = lane.blockCount.load(std::memory_order_relaxed);
+        auto& stamp = getStamps(lane)[blockIndex % BusBlockStamp::ringSize];
+        stamp.ringPos = writeIndex;
+        stamp.numSamples = numSamples;
+        stamp.sequence = blockIndex;
+        const int64_t now = getMonotonicNanos();
+        stamp.timelineSample = timelineSample;
+        stamp.timeNanos = now - (int64_t)(latencySeconds * 1.0e9);
+        stamp.sampleRate = lane.format.sampleRate;
+        lane.blockCount.store(blockIndex + 1, std::memory_order_release);
+
+        lane.writePos.store(writeIndex + (uint32_t)numSamples, std::memory_order_release);
+        lane.totalWritten.store(lane.totalWritten.load(std::memory_order_relaxed) + numSamples, std::memory_order_relaxed);
+        lane.writerTiming.heartbeatNanos.store(now, std::memory_order_relaxed); // Sending counts as calling in
+        lane.writerInside.store(0, std::memory_order_release);
     }
 
-    // Called by Bus Alpha 5 to read from a specific channel  
+    // Stereo sum of all lanes on a channel: each lane's first two channels (a mono lane feeds
+    // both sides). Layout-aware mixing of multichannel lanes is BusDriftReader's job.
     void readFromChannel(int channelID, float* left, float* right, int numSamples) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32)
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs)
         {
             juce::FloatVectorOperations::clear(left, numSamples);
             if (right) juce::FloatVectorOperations::clear(right, numSamples);
             return;
         }
 
-        int channelIndex = channelID - 1;
-        auto& channel = sharedBuffer->channels[channelIndex];
+        auto& channel = sharedBuffer->channels[channelID - 1];
+
+        // Lets a writer that is releasing its ring wait until we're done with it
+        channel.readersInside.fetch_add(1, std::memory_order_seq_cst);
+
+        const int64_t now = getMonotonicNanos();
+        const bool anySoloed = isAnyLaneSoloed(channel, now);
+        int lanesSummed = 0;
+
+        for (auto& lane : channel.lanes)
+        {
+            if (lane.state.load(std::memory_order_seq_cst) != SourceLane::laneActive || numSamples > lane.capacity)
+                continue;
+
+            if (isStalled(lane, now))
+            {
+                dropQueuedAudio(lane);
+                continue;
+            }
+
+            applyClear(lane);
+
+            const float* leftRing = getRing(lane, 0);
+            const float* rightRing = getRing(lane, lane.format.numChannels > 1 ? 1 : 0);
 
-        const int mask = ChannelRingBuffer::bufferSizeSamples - 1;
-        int writeIndex = channel.writePos.load(std::memory_order_acquire);
-        int readIndex = channel.readPos.load(std::memory_order_acquire);
+            uint32_t readIndex = lane.readPos.load(std::memory_order_relaxed);
+            uint32_t available = lane.readerCachedWritePos - readIndex;
 
-        // Calculate available samples (like Loopback)
-        int available = (writeIndex - readIndex) & mask;
+            // Only look at the writer's line when our cached copy runs short
+            if (available < (uint32_t)numSamples || available > (uint32_t)lane.capacity)
+            {
+                lane.readerCachedWritePos = lane.writePos.load(std::memory_order_acquire);
+                available = lane.readerCachedWritePos - readIndex;
+            }
+
+            // Writer lapped us (or the lane was re-claimed mid-read), or has started overwriting
+            // what we were about to play: resync to the newest block rather than replay old audio.
+            // A writer that laps us during the copy itself is only caught on the per-lane path.
+            if (available > (uint32_t)lane.capacity || !isLaneDataIntact(lane, readIndex))
+            {
+                readIndex = lane.readerCachedWritePos - (uint32_t)numSamples;
+                available = (uint32_t)numSamples;
+            }
+
+            // This source has not delivered a full block yet - it contributes silence
+            if (available < (uint32_t)numSamples)
+                continue;
+
+            // The first source is copied straight into the output, the rest are summed onto it.
+            // Silent ones (muted, or soloed out) are still consumed so they stay in step.
+            const float gain = getLaneMix(lane).getEffectiveGain(anySoloed);
+
+            if (gain != 0.0f)
+            {
+                const RingSpans spans(readIndex, numSamples, lane.capacity);
+                readFromRing(left, leftRing, spans, lanesSummed > 0, gain);
+                if (right) readFromRing(right, rightRing, spans, lanesSummed > 0, gain);
+                ++lanesSummed;
+            }
+
+            lane.readPos.store(readIndex + (uint32_t)numSamples, std::memory_order_release);
+        }
+
+        channel.readersInside.fetch_sub(1, std::memory_order_release);
+        channel.totalRead.fetch_add(numSamples, std::memory_order_relaxed);
 
-        // If no data, output silence
-        if (available < numSamples)
+        if (lanesSummed == 0)
         {
             juce::FloatVectorOperations::clear(left, numSamples);
             if (right) juce::FloatVectorOperations::clear(right, numSamples);
-            return;
         }
+    }
+
+    // Per-lane access for readers that pace each source themselves (see BusDriftReader).
+    // The lane calls are only valid between beginChannelRead() and endChannelRead().
+    bool beginChannelRead(int channelID) noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return false;
+
+        // Lets a writer that is releasing its ring wait until we're done with it
+        sharedBuffer->channels[channelID - 1].readersInside.fetch_add(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    void endChannelRead(int channelID, int numSamplesRead) noexcept
+    {
+        auto& channel = sharedBuffer->channels[channelID - 1];
+        channel.readersInside.fetch_sub(1, std::memory_order_release);
+        channel.totalRead.fetch_add(numSamplesRead, std::memory_order_relaxed);
+    }
+
+    // Snapshot of a lane for a reader. Returns false if the lane isn't carrying audio,
+    // which includes a writer that has stopped calling in.
+    bool getLaneStatus(int channelID, int laneIndex, BusLaneStatus& status) noexcept
+    {
+        auto& lane = sharedBuffer->channels[channelID - 1].lanes[laneIndex];
 
-        // Read samples (NO CLEARING - like Loopback!)
-        for (int i = 0; i < numSamples; ++i)
+        if (lane.state.load(std::memory_order_seq_cst) != SourceLane::laneActive)
+            return false;
+
+        // A crashed or frozen writer drops out here instead of leaving its last audio to be replayed
+        if (isStalled(lane, getMonotonicNanos()))
         {
-            int idx = (readIndex + i) & mask;
+            dropQueuedAudio(lane);
+            return false;
+        }
 
-            left[i] = channel.leftChannel[idx];
-            if (right) right[i] = channel.rightChannel[idx];
+        applyClear(lane);
 
-            // NO CLEARING! Data stays in buffer
+        lane.readerCachedWritePos = lane.writePos.load(std::memory_order_acquire);
+        uint32_t readIndex = lane.readPos.load(std::memory_order_relaxed);
+
+        // Writer lapped us: what's left in the ring is being overwritten, so start over empty
+        if (lane.readerCachedWritePos - readIndex > (uint32_t)lane.capacity)
+        {
+            readIndex = lane.readerCachedWritePos;
+            lane.readPos.store(readIndex, std::memory_order_release);
         }
 
-        // Update read position
-        channel.readPos.store((readIndex + numSamples) & mask, std::memory_order_release);
-        channel.totalRead.fetch_add(numSamples, std::memory_order_relaxed);
+        status.available = (int)(lane.readerCachedWritePos - readIndex);
+        status.generation = lane.generation;
+        status.readPos = readIndex;
+        status.writePos = lane.readerCachedWritePos;
+        status.format = lane.format;
+        status.processId = lane.processId;
+        status.mix = getLaneMix(lane);
+        status.clearEpoch = lane.readerClearEpoch;
+        return true;
     }
 
-    // Register/unregister writers
-    void registerWriter(int channelID) noexcept
+    // Finds the stamp of the block holding lane position `position`. Only blocks up to the
+    // writePos of the last getLaneStatus() are considered. Returns false if it's too old.
+    bool findLaneStamp(int channelID, int laneIndex, uint32_t position, BusBlockStamp& result) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return;
-        int result = sharedBuffer->channels[channelID - 1].activeWriters.fetch_add(1, std::memory_order_relaxed);
-        DBG("BusShared: Registered writer for channel " << channelID << " (now " << (result + 1) << " writers)");
+        auto& lane = sharedBuffer->channels[channelID - 1].lanes[laneIndex];
+        const BusBlockStamp* stamps = getStamps(lane);
+        const uint32_t newest = lane.blockCount.load(std::memory_order_acquire);
+
+        for (uint32_t age = 1; age <= juce::jmin(newest, (uint32_t)BusBlockStamp::ringSize); ++age)
+        {
+            const uint32_t blockIndex = newest - age;
+            result = stamps[blockIndex % BusBlockStamp::ringSize];
+
+            // The writer may have reused the slot while we copied it, or it's left over from an earlier stream
+            if (lane.blockCount.load(std::memory_order_acquire) - blockIndex >= (uint32_t)BusBlockStamp::ringSize
+                || result.sequence != blockIndex)
+                return false;
+
+            // Published after our writePos snapshot
+            if ((int32_t)(result.ringPos - lane.readerCachedWritePos) >= 0)
+                continue;
+
+            if (position - result.ringPos < (uint32_t)result.numSamples)
+                return true;
+
+            // Blocks are in order, so once we're past the position it isn't in the history
+            if ((int32_t)(position - result.ringPos) > 0)
+                return false;
+        }
+
+        return false;
     }
 
-    void unregisterWriter(int channelID) noexcept
+    // Points a view at the oldest numSamples of a lane without copying or consuming them.
+    // The caller has checked getLaneStatus() first and asks for no more than is available.
+    void getLaneView(int channelID, int laneIndex, int numSamples, BusLaneView& view) const noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return;
-        int result = sharedBuffer->channels[channelID - 1].activeWriters.fetch_sub(1, std::memory_order_relaxed);
-        DBG("BusShared: Unregistered writer for channel " << channelID << " (now " << (result - 1) << " writers)");
+        const auto& lane = sharedBuffer->channels[channelID - 1].lanes[laneIndex];
+        const uint32_t readIndex = lane.readPos.load(std::memory_order_relaxed);
+        const RingSpans spans(readIndex, numSamples, lane.capacity);
+
+        view.numChannels = lane.format.numChannels;
+        view.position = readIndex;
+        view.firstLength = spans.first;
+        view.secondLength = spans.second;
+
+        for (int ch = 0; ch < lane.format.numChannels; ++ch)
+        {
+            const float* ring = getRing(lane, ch);
+            view.first[ch] = ring + spans.start;
+            view.second[ch] = ring;
+        }
     }
 
-    int getActiveWriters(int channelID) const noexcept
+    // Whether the audio a reader has just taken out of a lane, from position on, is still what
+    // the writer put there. The ring never blocks its writer, so one that gets more than a
+    // ring ahead (the reader was held up) overwrites the oldest audio, possibly while it's
+    // being read; call this after reading or processing a view and drop the result if it's
+    // false. The writer's sequence numbers are the free-running positions: it announces the
+    // end of each block (writeReserve) before its samples, like a seqlock.
+    bool isLaneDataIntact(int channelID, int laneIndex, uint32_t position) const noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return 0;
-        return sharedBuffer->channels[channelID - 1].activeWriters.load(std::memory_order_relaxed);
+        return isLaneDataIntact(sharedBuffer->channels[channelID - 1].lanes[laneIndex], position);
     }
 
-    int getNumAvailable(int channelID) const noexcept
+    // Copies the oldest numSamples of a lane without consuming them. The caller has checked
+    // getLaneStatus() first. Takes the lane's first two channels (a mono lane feeds both).
+    void peekLane(int channelID, int laneIndex, float* left, float* right, int numSamples) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return 0;
+        auto& lane = sharedBuffer->channels[channelID - 1].lanes[laneIndex];
+        const RingSpans spans(lane.readPos.load(std::memory_order_relaxed), numSamples, lane.capacity);
 
-        auto& channel = sharedBuffer->channels[channelID - 1];
-        int writeIndex = channel.writePos.load(std::memory_order_acquire);
-        int readIndex = channel.readPos.load(std::memory_order_acquire);
-        return (writeIndex - readIndex) & (ChannelRingBuffer::bufferSizeSamples - 1);
+        readFromRing(left, getRing(lane, 0), spans, false);
+        readFromRing(right, getRing(lane, lane.format.numChannels > 1 ? 1 : 0), spans, false);
     }
 
-    int64_t getTotalWritten(int channelID) const noexcept
+    // Copies the lane's channels in its own layout (see BusLaneStatus::format). Destination
+    // channels the lane doesn't have are cleared.
+    void peekLane(int channelID, int laneIndex, float* const* dest, int numDestChannels, int numSamples) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return 0;
-        return sharedBuffer->channels[channelID - 1].totalWritten.load(std::memory_order_relaxed);
+        auto& lane = sharedBuffer->channels[channelID - 1].lanes[laneIndex];
+        const RingSpans spans(lane.readPos.load(std::memory_order_relaxed), numSamples, lane.capacity);
+
+        for (int ch = 0; ch < numDestChannels; ++ch)
+        {
+            if (ch < lane.format.numChannels)
+                readFromRing(dest[ch], getRing(lane, ch), spans, false);
+            else
+                juce::FloatVectorOperations::clear(dest[ch], numSamples);
+        }
     }
 
-    int64_t getTotalRead(int channelID) const noexcept
+    void consumeLane(int channelID, int laneIndex, int numSamples) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return 0;
-        return sharedBuffer->channels[channelID - 1].totalRead.load(std::memory_order_relaxed);
+        auto& lane = sharedBuffer->channels[channelID - 1].lanes[laneIndex];
+        lane.readPos.store(lane.readPos.load(std::memory_order_relaxed) + (uint32_t)numSamples, std::memory_order_release);
     }
 
-    void clearChannel(int channelID) noexcept
+    // Claim a free lane on a channel. Returns an invalid handle if the channel is full.
+    // The lane carries no audio until prepareWriter() has given it a ring.
+    BusWriterHandle registerWriter(int channelID) noexcept
     {
-        if (!sharedBuffer || channelID < 1 || channelID > 32) return;
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return {};
+
+        // Lanes left behind by crashed hosts become free again first
+        reapDeadWriters();
 
         auto& channel = sharedBuffer->channels[channelID - 1];
 
-        for (int i = 0; i < ChannelRingBuffer::bufferSizeSamples; ++i)
+        for (int i = 0; i < ChannelRingBuffer::maxLanes; ++i)
         {
-            channel.leftChannel[i] = 0.0f;
-            channel.rightChannel[i] = 0.0f;
+            auto& lane = channel.lanes[i];
+            int expected = SourceLane::laneFree;
+
+            if (!lane.state.compare_exchange_strong(expected, SourceLane::laneClaimed, std::memory_order_acq_rel))
+                continue;
+
+            lane.processId = BusProcess::getCurrentId();
+            lane.instanceId = sharedBuffer->header.nextInstanceId.fetch_add(1, std::memory_order_relaxed);
+            lane.writerInside.store(0, std::memory_order_relaxed); // A reaped owner may have died inside
+            lane.stallNanos = (int64_t)BUSALPHA5_STALL_MS * 1000000;
+            lane.mixGain.store(1.0f, std::memory_order_relaxed);
+            lane.mixFlags.store(0, std::memory_order_relaxed);
+            lane.writerTiming.reset(); // Don't show the previous owner's figures
+            lane.writerTiming.heartbeatNanos.store(getMonotonicNanos(), std::memory_order_relaxed);
+
+            DBG("BusShared: Registered writer " << (juce::int64)lane.instanceId << " for channel " << channelID << " on lane " << i);
+            return { (int16_t)channelID, (int16_t)i, (uint32_t)lane.instanceId.load(std::memory_order_relaxed) };
         }
 
-        channel.writePos.store(0, std::memory_order_release);
-        channel.readPos.store(0, std::memory_order_release);
+        DBG("BusShared: No free lane on channel " << channelID);
+        return {};
     }
 
-private:
-    BusShared()
+    // Sizes the writer's ring from the host's sample rate and block size, allocating it
+    // from the pool. Call from prepareToPlay (never from the audio callback).
+    bool prepareWriter(BusWriterHandle writer, double sampleRate, int maximumBlockSize,
+                       const juce::AudioChannelSet& channelSet = juce::AudioChannelSet::stereo()) noexcept
     {
-#if JUCE_WINDOWS
-        const char* mapName = "Global\\BusAlpha5SharedMemory_V2";  // Changed version
+        if (!sharedBuffer || !writer.isValid() || writer.channelID < 1 || writer.channelID > busMaxChannelIDs) return false;
 
-        hMapFile = CreateFileMappingA(
-            INVALID_HANDLE_VALUE,
-            NULL,
-            PAGE_READWRITE,
-            0,
-            sizeof(BusSharedMemory),
-            mapName
-        );
+        auto& lane = sharedBuffer->channels[writer.channelID - 1].lanes[writer.lane];
+        const int capacity = getRingCapacityFor(sampleRate, maximumBlockSize);
 
-        if (hMapFile == NULL)
-        {
-            DBG("BusShared: FAILED to create file mapping - Error: " << GetLastError());
-            return;
-        }
+        if (!isOwnedBy(lane, writer)) return false;
 
-        bool existed = (GetLastError() == ERROR_ALREADY_EXISTS);
+        BusStreamFormat layout;
+        layout.setChannelSet(channelSet);
 
-        sharedBuffer = (BusSharedMemory*)MapViewOfFile(
-            hMapFile,
-            FILE_MAP_ALL_ACCESS,
-            0,
-            0,
-            sizeof(BusSharedMemory)
-        );
+        const int64_t stallNanos = juce::jmax((int64_t)BUSALPHA5_STALL_MS * 1000000, (int64_t)(4.0e9 * maximumBlockSize / sampleRate));
 
-        if (sharedBuffer == NULL)
+        // Same ring will do. A new sample rate still goes the long way round, even when the
+        // capacity comes out the same (44.1 and 48 kHz do): the fresh generation is what makes
+        // readers rebuild their converter for it.
+        if (lane.state.load(std::memory_order_acquire) == SourceLane::laneActive && lane.capacity == capacity
+            && lane.format.hasSameLayout(layout) && lane.format.sampleRate == sampleRate)
         {
-            DBG("BusShared: FAILED to map view of file - Error: " << GetLastError());
-            CloseHandle(hMapFile);
-            hMapFile = NULL;
-            return;
+            lane.format.maximumBlockSize = maximumBlockSize;
+            lane.stallNanos = stallNanos;
+            return true;
         }
 
-        if (!existed)
-        {
-            memset(sharedBuffer, 0, sizeof(BusSharedMemory));
-            DBG("BusShared: ✅ Created NEW shared memory (Size: " << sizeof(BusSharedMemory) << " bytes = " << (sizeof(BusSharedMemory) / 1024 / 1024) << " MB)");
-        }
-        else
+        releaseRing(writer);
+
+        const size_t ringBytes = getRingBytes(capacity, layout.numChannels);
+        const uint64_t offset = allocateFromPool(ringBytes);
+
+        if (offset == invalidOffset)
         {
-            DBG("BusShared: ✅ Opened EXISTING shared memory");
+            DBG("BusShared: Pool exhausted, channel " << writer.channelID << " lane " << writer.lane << " stays silent");
+            return false;
         }
-#endif
+
+        segment.commitPages((size_t)(sharedBuffer->header.poolOffset + offset), ringBytes);
+
+        lane.ringOffset = offset;
+        lane.capacity = capacity;
+        lane.format = layout;
+        lane.format.sampleRate = sampleRate;
+        lane.format.maximumBlockSize = maximumBlockSize;
+        lane.stallNanos = stallNanos;
+        lane.writerTiming.heartbeatNanos.store(getMonotonicNanos(), std::memory_order_relaxed);
+        std::memset(getRing(lane, 0), 0, ringBytes); // Also faults the pages in here rather than on the audio thread
+
+        // Start empty: whatever the previous owner left behind is never read. No reader is
+        // inside the lane while it isn't active, so its cached copy can be reset from here.
+        const uint32_t startPos = lane.readPos.load(std::memory_order_acquire);
+        lane.writePos.store(startPos, std::memory_order_relaxed);
+        lane.writeReserve.store(startPos, std::memory_order_relaxed);
+        lane.writerCachedReadPos = startPos;
+        lane.readerCachedWritePos = startPos;
+        lane.readerClearEpoch = lane.clearEpoch.load(std::memory_order_relaxed);
+        lane.blockCount.store(0, std::memory_order_relaxed);
+        ++lane.generation;
+        lane.state.store(SourceLane::laneActive, std::memory_order_seq_cst);
+        return true;
     }
 
-    ~BusShared()
+    void unregisterWriter(BusWriterHandle writer) noexcept
     {
-#if JUCE_WINDOWS
-        if (sharedBuffer)
+        if (!sharedBuffer || !writer.isValid() || writer.channelID < 1 || writer.channelID > busMaxChannelIDs) return;
+
+        auto& lane = sharedBuffer->channels[writer.channelID - 1].lanes[writer.lane];
+
+        if (!isOwnedBy(lane, writer)) return;
+
+        releaseRing(writer);
+        lane.processId = 0;
+        lane.instanceId = 0;
+        lane.state.store(SourceLane::laneFree, std::memory_order_release);
+
+        DBG("BusShared: Unregistered writer for channel " << writer.channelID << " lane " << writer.lane);
+    }
+
+    // Frees the lanes of writers whose process has died (crashed or killed host), drops
+    // their routes and gives back channel names that are no longer used. Lanes of live
+    // processes are never taken, even if frozen, since their owner may still write.
+    // Not for the audio thread. Returns the number of lanes reclaimed.
+    int reapDeadWriters() noexcept
+    {
+        if (!sharedBuffer) return 0;
+
+        const uint32_t self = BusProcess::getCurrentId();
+        const int64_t now = getMonotonicNanos();
+        int reaped = 0;
+
+        for (int channelIndex = 0; channelIndex < busMaxChannelIDs; ++channelIndex)
         {
-            UnmapViewOfFile(sharedBuffer);
-            sharedBuffer = nullptr;
+            auto& channel = sharedBuffer->channels[channelIndex];
+
+            for (auto& lane : channel.lanes)
+            {
+                int state = lane.state.load(std::memory_order_acquire);
+
+                // Only silent lanes are worth a process lookup
+                if ((state != SourceLane::laneClaimed && state != SourceLane::laneActive)
+                    || lane.processId == self || !isStalled(lane, now) || BusProcess::isAlive(lane.processId))
+                    continue;
+
+                // Whoever wins this owns the lane from here; a racing reaper moves on
+                if (!lane.state.compare_exchange_strong(state, SourceLane::laneReaping, std::memory_order_seq_cst))
+                    continue;
+
+                DBG("BusShared: Reaping writer " << (juce::int64)lane.instanceId << " of dead process " << (int)lane.processId
+                    << " on channel " << (channelIndex + 1));
+
+                if (lane.capacity > 0)
+                    freeLaneRing(channel, lane);
+
+                lane.processId = 0;
+                lane.instanceId = 0;
+                lane.state.store(SourceLane::laneFree, std::memory_order_release);
+                ++reaped;
+            }
         }
-        if (hMapFile)
+
+        reapDeadRoutes();
+        releaseUnusedNames();
+        return reaped;
+    }
+
+    // Writers on the channel that are calling in; lanes of crashed or frozen hosts don't count
+    int getActiveWriters(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0;
+
+        const int64_t now = getMonotonicNanos();
+        int count = 0;
+
+        for (auto& lane : sharedBuffer->channels[channelID - 1].lanes)
         {
-            CloseHandle(hMapFile);
-            hMapFile = NULL;
+            const int state = lane.state.load(std::memory_order_acquire);
+
+            if ((state == SourceLane::laneClaimed || state == SourceLane::laneActive) && !isStalled(lane, now))
+                ++count;
         }
-        DBG("BusShared: Cleaned up shared memory");
-#endif
+
+        return count;
     }
 
-    BusShared(const BusShared&) = delete;
-    BusShared& operator=(const BusShared&) = delete;
+    // Called by a reader when it starts reading a channel, so writers can see what it runs at
+    void publishReaderFormat(int channelID, double sampleRate, int maximumBlockSize, int numChannels = 2) noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return;
 
-#if JUCE_WINDOWS
-    HANDLE hMapFile = NULL;
-#endif
+        auto& channel = sharedBuffer->channels[channelID - 1];
+        channel.readerBlockSize.store(maximumBlockSize, std::memory_order_relaxed);
+        channel.readerNumChannels.store(numChannels, std::memory_order_relaxed);
+        channel.readerSampleRate.store(sampleRate, std::memory_order_relaxed);
+    }
+
+    BusStreamFormat getReaderFormat(int channelID) const noexcept
+    {
+        BusStreamFormat format;
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return format;
+
+        const auto& channel = sharedBuffer->channels[channelID - 1];
+        format.sampleRate = channel.readerSampleRate.load(std::memory_order_relaxed);
+        format.maximumBlockSize = channel.readerBlockSize.load(std::memory_order_relaxed);
+        format.numChannels = channel.readerNumChannels.load(std::memory_order_relaxed);
+        return format;
+    }
+
+    // Fill level of the fullest active lane on the channel
+    int getNumAvailable(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0;
+
+        int maxAvailable = 0;
+
+        for (auto& lane : sharedBuffer->channels[channelID - 1].lanes)
+        {
+            if (lane.state.load(std::memory_order_acquire) != SourceLane::laneActive)
+                continue;
+
+            uint32_t available = lane.writePos.load(std::memory_order_acquire) - lane.readPos.load(std::memory_order_acquire);
+            maxAvailable = juce::jmax(maxAvailable, (int)juce::jmin(available, (uint32_t)lane.capacity));
+        }
+
+        return maxAvailable;
+    }
+
+    int64_t getTotalWritten(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0;
+
+        int64_t total = 0;
+        for (auto& lane : sharedBuffer->channels[channelID - 1].lanes)
+            total += lane.totalWritten.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    // Blocks written over audio the bus hadn't read yet, across all lanes on the channel
+    int getOverruns(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0;
+
+        int total = 0;
+        for (auto& lane : sharedBuffer->channels[channelID - 1].lanes)
+            total += (int)lane.overruns.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    int64_t getTotalRead(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0;
+        return sharedBuffer->channels[channelID - 1].totalRead.load(std::memory_order_relaxed);
+    }
+
+    // Publishes the writer's level, mute and solo for the bus to apply. Cheap enough to call
+    // every block: it only stores when something changed, so readers' cached lines stay valid.
+    void setLaneMix(BusWriterHandle writer, const BusLaneMix& mix) noexcept
+    {
+        if (!sharedBuffer || !writer.isValid() || writer.channelID < 1 || writer.channelID > busMaxChannelIDs) return;
+
+        auto& lane = sharedBuffer->channels[writer.channelID - 1].lanes[writer.lane];
+        const uint32_t flags = (mix.muted ? mixMuted : 0u) | (mix.soloed ? mixSoloed : 0u);
+
+        if (!isOwnedBy(lane, writer))
+            return;
+
+        if (lane.mixGain.load(std::memory_order_relaxed) != mix.gain)
+            lane.mixGain.store(mix.gain, std::memory_order_relaxed);
+
+        if (lane.mixFlags.load(std::memory_order_relaxed) != flags)
+            lane.mixFlags.store(flags, std::memory_order_relaxed);
+    }
+
+    // Called by a writer at the end of its processBlock with the time the block started.
+    // Also serves as its heartbeat, whether or not it is sending.
+    void publishWriterTiming(BusWriterHandle writer, int64_t blockStartNanos, int numSamples) noexcept
+    {
+        if (!sharedBuffer || !writer.isValid() || writer.channelID < 1 || writer.channelID > busMaxChannelIDs) return;
+
+        auto& lane = sharedBuffer->channels[writer.channelID - 1].lanes[writer.lane];
+
+        if (isOwnedBy(lane, writer))
+            lane.writerTiming.publish(blockStartNanos, getMonotonicNanos(), numSamples, lane.format.sampleRate);
+    }
+
+    // Called by a reader at the end of its processBlock with the time the block started
+    void publishReaderTelemetry(int channelID, int64_t blockStartNanos, int numSamples, const BusReaderReport& report) noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return;
+
+        auto& channel = sharedBuffer->channels[channelID - 1];
+        channel.readerTelemetry.publish(blockStartNanos, getMonotonicNanos(), numSamples,
+            channel.readerSampleRate.load(std::memory_order_relaxed), report);
+    }
+
+    bool getChannelHealth(int channelID, BusChannelHealth& health) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return false;
+
+        const auto& channel = sharedBuffer->channels[channelID - 1];
+        const int64_t now = getMonotonicNanos();
+        health.activeWriters = getActiveWriters(channelID);
+
+        for (int i = 0; i < ChannelRingBuffer::maxLanes; ++i)
+        {
+            const auto& lane = channel.lanes[i];
+            auto& laneHealth = health.lanes[i];
+
+            laneHealth = {};
+            laneHealth.active = lane.state.load(std::memory_order_acquire) == SourceLane::laneActive;
+            if (!laneHealth.active)
+                continue;
+
+            laneHealth.stalled = isStalled(lane, now);
+            laneHealth.processId = lane.processId;
+            laneHealth.instanceId = lane.instanceId;
+            laneHealth.format = lane.format;
+            laneHealth.mix = getLaneMix(lane);
+            laneHealth.capacity = lane.capacity;
+            laneHealth.fill = (int)juce::jmin(lane.writePos.load(std::memory_order_acquire) - lane.readPos.load(std::memory_order_acquire),
+                                              (uint32_t)lane.capacity);
+            laneHealth.overruns = lane.overruns.load(std::memory_order_relaxed);
+            laneHealth.totalWritten = lane.totalWritten.load(std::memory_order_relaxed);
+            laneHealth.writer = getTimingSnapshot(lane.writerTiming);
+        }
+
+        const auto& telemetry = channel.readerTelemetry;
+        health.readerFormat = getReaderFormat(channelID);
+        health.reader = getTimingSnapshot(telemetry.timing);
+        health.fillLow = telemetry.fillLow.load(std::memory_order_relaxed);
+        health.fillHigh = telemetry.fillHigh.load(std::memory_order_relaxed);
+        health.underruns = telemetry.underruns.load(std::memory_order_relaxed);
+        health.staleReads = telemetry.staleReads.load(std::memory_order_relaxed);
+        health.driftPpm = telemetry.driftPpm.load(std::memory_order_relaxed);
+        health.totalRead = channel.totalRead.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    // Bytes of ring storage currently allocated across all hosts
+    int64_t getPoolBytesInUse() const noexcept
+    {
+        if (!sharedBuffer) return 0;
+        return (int64_t)sharedBuffer->header.pool.bytesInUse.load(std::memory_order_relaxed);
+    }
+
+    // Throws away everything queued on the channel: readers skip it on their next block, so
+    // it plays as silence. Touches one word per lane and no samples, so it's safe from any
+    // thread, the audio thread included.
+    void clearChannel(int channelID) noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return;
+
+        for (auto& lane : sharedBuffer->channels[channelID - 1].lanes)
+            lane.clearEpoch.fetch_add(1, std::memory_order_release);
+    }
+
+    // Gives the sample pages of lanes that have had no new audio for two calls back to the
+    // OS; the writer's next block faults them back in. Anything still queued is cleared
+    // first, since the pages may read as zero afterwards. Meant for a timer, not the audio
+    // thread. Returns the number of lanes released.
+    int releaseIdleRings() noexcept
+    {
+        if (!sharedBuffer) return 0;
+
+        int released = 0;
+
+        for (auto& channel : sharedBuffer->channels)
+        {
+            for (auto& lane : channel.lanes)
+            {
+                if (lane.state.load(std::memory_order_acquire) != SourceLane::laneActive)
+                    continue;
+
+                const uint32_t writeIndex = lane.writePos.load(std::memory_order_relaxed);
+
+                if (writeIndex != lane.idleWritePos.load(std::memory_order_relaxed))
+                {
+                    lane.idleWritePos.store(writeIndex, std::memory_order_relaxed);
+                    lane.idleScans.store(0, std::memory_order_relaxed);
+                    continue;
+                }
+
+                // Exactly one caller (in any process) gets to release an idle stretch
+                if (lane.idleScans.fetch_add(1, std::memory_order_relaxed) != 1)
+                    continue;
+
+                // Holding the pool keeps the owner from freeing the ring (and someone else
+                // from reusing it) while its pages are handed back
+                lockPool();
+
+                if (lane.state.load(std::memory_order_acquire) == SourceLane::laneActive
+                    && lane.writePos.load(std::memory_order_relaxed) == writeIndex)
+                {
+                    const size_t sampleBytes = (size_t)lane.capacity * (size_t)lane.format.numChannels * sizeof(float);
+
+                    lane.clearEpoch.fetch_add(1, std::memory_order_seq_cst);
+                    segment.releasePages((size_t)(sharedBuffer->header.poolOffset + lane.ringOffset),
+                        sampleBytes / BusPoolDirectory::granuleBytes * BusPoolDirectory::granuleBytes); // Stamps stay
+
+                    // Nothing stops the writer from waking up meanwhile, and a block it wrote
+                    // (partly) before the pages went may now read as zeros. Once it's out of the
+                    // ring, anything it started since the check is thrown away as well; blocks
+                    // it starts from here on land on the fresh pages.
+                    for (int attempt = 0; attempt < 200 && lane.writerInside.load(std::memory_order_seq_cst) != 0; ++attempt)
+                        juce::Thread::sleep(1);
+
+                    if (lane.writeReserve.load(std::memory_order_seq_cst) != writeIndex)
+                        lane.clearEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+                    ++released;
+                }
+
+                unlockPool();
+            }
+        }
+
+        return released;
+    }
+
+    // Routes the mix read on fromChannel onto toChannel, latencySeconds behind (the reading
+    // bus's own delay). Not for the audio thread. Returns the route's index, or -1 if the
+    // route would form a loop (a channel feeding itself, directly or through other buses)
+    // or the table is full.
+    int addRoute(int fromChannel, int toChannel, double latencySeconds) noexcept
+    {
+        if (!sharedBuffer || fromChannel < 1 || fromChannel > busMaxChannelIDs || toChannel < 1 || toChannel > busMaxChannelIDs) return -1;
+
+        auto& table = sharedBuffer->routes;
+        int result = -1;
+
+        lockRoutes();
+
+        if (!feedsInto(table, toChannel, fromChannel))
+        {
+            for (int i = 0; i < BusRouteTable::maxRoutes; ++i)
+            {
+                auto& route = table.routes[i];
+
+                if (route.fromChannel != 0)
+                    continue;
+
+                route.fromChannel = fromChannel;
+                route.toChannel = toChannel;
+                route.latencySeconds = (float)juce::jmax(0.0, latencySeconds);
+                route.processId = BusProcess::getCurrentId();
+                rebuildRouteGraph(table);
+                result = i;
+                break;
+            }
+        }
+
+        unlockRoutes();
+
+        if (result < 0)
+            DBG("BusShared: Refused route from channel " << fromChannel << " to channel " << toChannel);
+
+        return result;
+    }
+
+    void removeRoute(int route) noexcept
+    {
+        if (!sharedBuffer || route < 0 || route >= BusRouteTable::maxRoutes) return;
+
+        auto& table = sharedBuffer->routes;
+
+        lockRoutes();
+        table.routes[route] = {};
+        rebuildRouteGraph(table);
+        unlockRoutes();
+    }
+
+    // For when the reading bus's delay changes (target latency, sample rate)
+    void setRouteLatency(int route, double latencySeconds) noexcept
+    {
+        if (!sharedBuffer || route < 0 || route >= BusRouteTable::maxRoutes) return;
+
+        auto& table = sharedBuffer->routes;
+
+        lockRoutes();
+
+        if (table.routes[route].fromChannel != 0)
+        {
+            table.routes[route].latencySeconds = (float)juce::jmax(0.0, latencySeconds);
+            rebuildRouteGraph(table);
+        }
+
+        unlockRoutes();
+    }
+
+    // Hops on the longest chain of routes into the channel; 0 if only senders feed it
+    int getChannelDepth(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0;
+        return sharedBuffer->routes.depth[channelID - 1].load(std::memory_order_relaxed);
+    }
+
+    // How far the routed audio arriving on the channel already lags its original senders,
+    // over the slowest path. A bus re-publishing the channel adds its own delay to this.
+    double getPathLatencySeconds(int channelID) const noexcept
+    {
+        if (!sharedBuffer || channelID < 1 || channelID > busMaxChannelIDs) return 0.0;
+        return sharedBuffer->routes.pathLatency[channelID - 1].load(std::memory_order_relaxed);
+    }
+
+    // Every channel ID, each channel ahead of the ones it's routed onto
+    void getSchedule(int (&channelIDs)[busMaxChannelIDs]) const noexcept
+    {
+        int depths[busMaxChannelIDs] = {};
+
+        for (int i = 0; i < busMaxChannelIDs; ++i)
+        {
+            channelIDs[i] = i + 1;
+            depths[i] = getChannelDepth(i + 1);
+        }
+
+        std::stable_sort(channelIDs, channelIDs + busMaxChannelIDs, [&depths](int a, int b) { return depths[a - 1] < depths[b - 1]; });
+    }
+
+    // Copies the routes in use, upstream hops first. Returns how many there are.
+    int getRoutes(BusRoute* result, int maxRoutes) noexcept
+    {
+        if (!sharedBuffer) return 0;
+
+        auto& table = sharedBuffer->routes;
+        int numRoutes = 0;
+
+        lockRoutes();
+
+        for (auto& route : table.routes)
+            if (route.fromChannel != 0 && numRoutes < maxRoutes)
+                result[numRoutes++] = route;
+
+        unlockRoutes();
+
+        std::stable_sort(result, result + numRoutes, [this](const BusRoute& a, const BusRoute& b)
+            { return getChannelDepth(a.fromChannel) < getChannelDepth(b.fromChannel); });
+
+        return numRoutes;
+    }
+
+    // Channel ID of a named channel ("drums/kick"), giving it a free ID on first use; "1" to
+    // "32" are the numbered channels themselves. Every call keeps the name alive: once nobody
+    // has looked it up for a while and nothing writes, reads or routes on its channel,
+    // reapDeadWriters() hands the ID back. Returns 0 for an empty or overlong name, or when
+    // every channel ID is taken. Not for the audio thread.
+    int acquireNamedChannel(const char* name) noexcept
+    {
+        if (!sharedBuffer || name == nullptr) return 0;
+
+        if (const int numbered = parseNumberedChannel(name))
+            return numbered;
+
+        const size_t length = std::strlen(name);
+        if (length == 0 || length > (size_t)BusChannelName::maxLength) return 0;
+
+        auto& directory = sharedBuffer->directory;
+        const uint32_t hash = hashName(name);
+        int channelID = 0;
+
+        lockDirectory();
+
+        auto& entry = directory.slots[findSlot(directory, name, hash)];
+
+        if (entry.hash != 0)
+        {
+            channelID = entry.channelID;
+        }
+        else if ((channelID = findFreeNamedChannel(directory)) != 0)
+        {
+            entry.hash = hash;
+            entry.channelID = channelID;
+            std::memcpy(entry.name, name, length + 1);
+            directory.slotOfChannel[channelID - 1] = (int)(&entry - directory.slots) + 1;
+            resetReaderSide(sharedBuffer->channels[channelID - 1]); // Don't show the previous name's figures
+
+            DBG("BusShared: Channel " << channelID << " is now \"" << name << "\"");
+        }
+
+        if (channelID != 0)
+            entry.lastUsedNanos = getMonotonicNanos();
+
+        unlockDirectory();
+        return channelID;
+    }
+
+    // Channel ID of a name that's in use (or a numbered one), without creating it; 0 if none
+    int findNamedChannel(const char* name) noexcept
+    {
+        if (!sharedBuffer || name == nullptr) return 0;
+
+        if (const int numbered = parseNumberedChannel(name))
+            return numbered;
+
+        auto& directory = sharedBuffer->directory;
+
+        lockDirectory();
+        const int channelID = directory.slots[findSlot(directory, name, hashName(name))].channelID;
+        unlockDirectory();
+
+        return channelID;
+    }
+
+    // Name of a channel handed out by acquireNamedChannel(); false for numbered or unused IDs
+    bool getChannelName(int channelID, char* name, size_t size) noexcept
+    {
+        if (!sharedBuffer || channelID <= busNumberedChannels || channelID > busMaxChannelIDs || size == 0) return false;
+
+        auto& directory = sharedBuffer->directory;
+
+        lockDirectory();
+        const int slot = directory.slotOfChannel[channelID - 1];
+
+        if (slot > 0)
+            std::snprintf(name, size, "%s", directory.slots[slot - 1].name);
+
+        unlockDirectory();
+        return slot > 0;
+    }
+
+    // Ring length for a host running at this rate and block size
+    static int getRingCapacityFor(double sampleRate, int maximumBlockSize) noexcept
+    {
+        const int latencySamples = (int)std::ceil(juce::jmax(8000.0, sampleRate) * BUSALPHA5_MAX_LATENCY_MS / 1000.0);
+        return juce::nextPowerOfTwo(juce::jmax(latencySamples, maximumBlockSize * 4));
+    }
+
+    // Clock used for block stamps. It is system-wide, so stamps compare across processes.
+    static int64_t getMonotonicNanos() noexcept
+    {
+        static const double nanosPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        return (int64_t)((double)juce::Time::getHighResolutionTicks() * nanosPerTick);
+    }
+
+    // Why the segment is unavailable, for display in the editors
+    const char* getStatusMessage() const noexcept { return statusMessage; }
+
+private:
+    static constexpr uint64_t invalidOffset = ~(uint64_t)0;
+
+    // A block at a free-running ring position splits into at most two contiguous runs:
+    // [start, start + first) and, if it wraps, [0, second)
+    struct RingSpans
+    {
+        RingSpans(uint32_t position, int numSamples, int capacity) noexcept
+            : start((int)(position & ((uint32_t)capacity - 1))),
+              first(juce::jmin(numSamples, capacity - start)),
+              second(numSamples - first)
+        {
+        }
+
+        int start, first, second;
+    };
+
+    static void copyToRing(float* ring, const RingSpans& spans, const float* source) noexcept
+    {
+        juce::FloatVectorOperations::copy(ring + spans.start, source, spans.first);
+        if (spans.second > 0)
+            juce::FloatVectorOperations::copy(ring, source + spans.first, spans.second);
+    }
+
+    static void readFromRing(float* dest, const float* ring, const RingSpans& spans, bool addToDest, float gain = 1.0f) noexcept
+    {
+        if (gain != 1.0f)
+        {
+            if (addToDest)
+            {
+                juce::FloatVectorOperations::addWithMultiply(dest, ring + spans.start, gain, spans.first);
+                if (spans.second > 0)
+                    juce::FloatVectorOperations::addWithMultiply(dest + spans.first, ring, gain, spans.second);
+            }
+            else
+            {
+                juce::FloatVectorOperations::copyWithMultiply(dest, ring + spans.start, gain, spans.first);
+                if (spans.second > 0)
+                    juce::FloatVectorOperations::copyWithMultiply(dest + spans.first, ring, gain, spans.second);
+            }
+        }
+        else if (addToDest)
+        {
+            juce::FloatVectorOperations::add(dest, ring + spans.start, spans.first);
+            if (spans.second > 0)
+                juce::FloatVectorOperations::add(dest + spans.first, ring, spans.second);
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(dest, ring + spans.start, spans.first);
+            if (spans.second > 0)
+                juce::FloatVectorOperations::copy(dest + spans.first, ring, spans.second);
+        }
+    }
+
+    static constexpr uint32_t mixMuted = 1;
+    static constexpr uint32_t mixSoloed = 2;
+
+    static BusLaneMix getLaneMix(const SourceLane& lane) noexcept
+    {
+        const uint32_t flags = lane.mixFlags.load(std::memory_order_relaxed);
+
+        BusLaneMix mix;
+        mix.gain = lane.mixGain.load(std::memory_order_relaxed);
+        mix.muted = (flags & mixMuted) != 0;
+        mix.soloed = (flags & mixSoloed) != 0;
+        return mix;
+    }
+
+    // A stalled writer's solo doesn't count, or a frozen host could silence the whole channel
+    static bool isAnyLaneSoloed(const ChannelRingBuffer& channel, int64_t now) noexcept
+    {
+        for (auto& lane : channel.lanes)
+            if (lane.state.load(std::memory_order_relaxed) == SourceLane::laneActive
+                && (lane.mixFlags.load(std::memory_order_relaxed) & mixSoloed) != 0 && !isStalled(lane, now))
+                return true;
+
+        return false;
+    }
+
+    // Channels are stored one after the other, capacity samples each
+    float* getRing(const SourceLane& lane, int channel) const noexcept
+    {
+        auto* base = reinterpret_cast<char*>(sharedBuffer) + sharedBuffer->header.poolOffset;
+        return reinterpret_cast<float*>(base + lane.ringOffset) + (size_t)channel * (size_t)lane.capacity;
+    }
+
+    // Block stamps follow the samples in the lane's pool allocation
+    BusBlockStamp* getStamps(const SourceLane& lane) const noexcept
+    {
+        return reinterpret_cast<BusBlockStamp*>(getRing(lane, lane.format.numChannels));
+    }
+
+    static BusTimingSnapshot getTimingSnapshot(const BusBlockTiming& timing) noexcept
+    {
+        BusTimingSnapshot snapshot;
+        snapshot.heartbeatNanos = timing.heartbeatNanos.load(std::memory_order_acquire);
+        snapshot.blockNanos = timing.blockNanos.load(std::memory_order_relaxed);
+        snapshot.peakBlockNanos = timing.peakBlockNanos.load(std::memory_order_relaxed);
+        snapshot.budgetNanos = timing.budgetNanos.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    static size_t getRingBytes(int capacity, int numChannels) noexcept
+    {
+        return (size_t)capacity * (size_t)numChannels * sizeof(float) + BusBlockStamp::ringSize * sizeof(BusBlockStamp);
+    }
+
+    // Takes the lane out of the readers' sum, then frees its ring
+    void releaseRing(BusWriterHandle writer) noexcept
+    {
+        auto& channel = sharedBuffer->channels[writer.channelID - 1];
+        auto& lane = channel.lanes[writer.lane];
+
+        int expected = SourceLane::laneActive;
+        if (!lane.state.compare_exchange_strong(expected, SourceLane::laneClaimed, std::memory_order_seq_cst))
+            return;
+
+        freeLaneRing(channel, lane);
+    }
+
+    // Waits for any reader still inside the channel, and for the lane's own writer if it's
+    // mid-block on another thread, then hands the lane's ring back to the pool. The lane must
+    // already be out of the laneActive state.
+    void freeLaneRing(ChannelRingBuffer& channel, SourceLane& lane) noexcept
+    {
+        // Both hold on for one block at most; one that died inside is given up on
+        for (int attempt = 0; attempt < 200 && (channel.readersInside.load(std::memory_order_seq_cst) > 0
+                                                 || lane.writerInside.load(std::memory_order_seq_cst) != 0); ++attempt)
+            juce::Thread::sleep(1);
+
+        freeToPool(lane.ringOffset, getRingBytes(lane.capacity, lane.format.numChannels));
+        lane.capacity = 0;
+    }
+
+    // The handle was given out for the lane's current claim, not an earlier owner's
+    static bool isOwnedBy(const SourceLane& lane, BusWriterHandle writer) noexcept
+    {
+        return (uint32_t)lane.instanceId.load(std::memory_order_relaxed) == writer.instance;
+    }
+
+    // No heartbeat for longer than the lane allows: its host crashed, froze or stopped processing
+    static bool isStalled(const SourceLane& lane, int64_t now) noexcept
+    {
+        return now - lane.writerTiming.heartbeatNanos.load(std::memory_order_relaxed) > lane.stallNanos;
+    }
+
+    // Nothing from position on has been overwritten yet: the writer's announced end is at most
+    // a ring ahead of it
+    static bool isLaneDataIntact(const SourceLane& lane, uint32_t position) noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return lane.writeReserve.load(std::memory_order_relaxed) - position <= (uint32_t)lane.capacity;
+    }
+
+    // Reader side: acts on a clearChannel() since the last block
+    static void applyClear(SourceLane& lane) noexcept
+    {
+        const uint32_t epoch = lane.clearEpoch.load(std::memory_order_acquire);
+
+        if (epoch != lane.readerClearEpoch)
+        {
+            dropQueuedAudio(lane);
+            lane.readerClearEpoch = epoch;
+        }
+    }
+
+    // Reader side: skips whatever the lane has queued, so a writer that comes back starts fresh
+    static void dropQueuedAudio(SourceLane& lane) noexcept
+    {
+        lane.readerCachedWritePos = lane.writePos.load(std::memory_order_acquire);
+        lane.readPos.store(lane.readerCachedWritePos, std::memory_order_release);
+    }
+
+    // Cross-process locks around the pool bitmap, the route table and the channel directory
+    // (taken before the route lock when both are needed). If the holder's process has died
+    // (crashed host) the lock is taken over.
+    void lockPool() noexcept { lockProcessWide(sharedBuffer->header.pool.lockOwner); }
+    void unlockPool() noexcept { sharedBuffer->header.pool.lockOwner.store(0, std::memory_order_release); }
+    void lockRoutes() noexcept { lockProcessWide(sharedBuffer->routes.lockOwner); }
+    void unlockRoutes() noexcept { sharedBuffer->routes.lockOwner.store(0, std::memory_order_release); }
+    void lockDirectory() noexcept { lockProcessWide(sharedBuffer->directory.lockOwner); }
+    void unlockDirectory() noexcept { sharedBuffer->directory.lockOwner.store(0, std::memory_order_release); }
+
+    static void lockProcessWide(std::atomic<uint32_t>& owner) noexcept
+    {
+        const uint32_t self = BusProcess::getCurrentId();
+
+        for (;;)
+        {
+            uint32_t expected = 0;
+
+            if (owner.compare_exchange_weak(expected, self, std::memory_order_acquire))
+                return;
+
+            if (expected != 0 && !BusProcess::isAlive(expected)
+                && owner.compare_exchange_strong(expected, self, std::memory_order_acquire))
+            {
+                DBG("BusShared: Took over lock from dead process " << (int)expected);
+                return;
+            }
+
+            juce::Thread::yield();
+        }
+    }
+
+    // Whether routes carry the source channel's audio to the destination, directly or
+    // through other channels (a channel counts as feeding itself)
+    static bool feedsInto(const BusRouteTable& table, int sourceChannel, int destChannel) noexcept
+    {
+        bool reached[busMaxChannelIDs] = {};
+        reached[sourceChannel - 1] = true;
+
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+
+            for (auto& route : table.routes)
+            {
+                if (route.fromChannel != 0 && reached[route.fromChannel - 1] && !reached[route.toChannel - 1])
+                {
+                    reached[route.toChannel - 1] = true;
+                    changed = true;
+                }
+            }
+        }
+
+        return reached[destChannel - 1];
+    }
+
+    // Depths and path latencies in topological order (Kahn): a channel is settled once every
+    // route into it is. Loops are refused on the way in, so every channel gets settled.
+    // Call with the route lock held.
+    static void rebuildRouteGraph(BusRouteTable& table) noexcept
+    {
+        int pendingInputs[busMaxChannelIDs] = {};
+        int depth[busMaxChannelIDs] = {};
+        float pathLatency[busMaxChannelIDs] = {};
+        int queue[busMaxChannelIDs];
+        int queueEnd = 0;
+
+        for (auto& route : table.routes)
+            if (route.fromChannel != 0)
+                ++pendingInputs[route.toChannel - 1];
+
+        for (int i = 0; i < busMaxChannelIDs; ++i)
+            if (pendingInputs[i] == 0)
+                queue[queueEnd++] = i;
+
+        for (int next = 0; next < queueEnd; ++next)
+        {
+            const int from = queue[next];
+
+            for (auto& route : table.routes)
+            {
+                if (route.fromChannel != from + 1)
+                    continue;
+
+                const int to = route.toChannel - 1;
+                depth[to] = juce::jmax(depth[to], depth[from] + 1);
+                pathLatency[to] = juce::jmax(pathLatency[to], pathLatency[from] + route.latencySeconds);
+
+                if (--pendingInputs[to] == 0)
+                    queue[queueEnd++] = to;
+            }
+        }
+
+        jassert(queueEnd == busMaxChannelIDs);
+
+        for (int i = 0; i < busMaxChannelIDs; ++i)
+        {
+            table.depth[i].store(depth[i], std::memory_order_relaxed);
+            table.pathLatency[i].store(pathLatency[i], std::memory_order_relaxed);
+        }
+
+        table.version.fetch_add(1, std::memory_order_release);
+    }
+
+    // "1" to "32" name the numbered channels; anything else is 0
+    static int parseNumberedChannel(const char* name) noexcept
+    {
+        int value = 0;
+
+        for (const char* c = name; *c != 0; ++c)
+        {
+            if (*c < '0' || *c > '9' || value > busNumberedChannels)
+                return 0;
+
+            value = value * 10 + (*c - '0');
+        }
+
+        return value <= busNumberedChannels ? value : 0;
+    }
+
+    // FNV-1a, never 0 (which marks an empty slot)
+    static uint32_t hashName(const char* name) noexcept
+    {
+        uint32_t hash = 2166136261u;
+
+        for (const char* c = name; *c != 0; ++c)
+            hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+        return hash != 0 ? hash : 1;
+    }
+
+    // Slot holding the name, or the empty slot where it would go. The table is never more
+    // than half full, so a probe always ends.
+    static int findSlot(const BusChannelDirectory& directory, const char* name, uint32_t hash) noexcept
+    {
+        int slot = (int)(hash % BusChannelDirectory::numSlots);
+
+        while (directory.slots[slot].hash != 0
+               && (directory.slots[slot].hash != hash || std::strcmp(directory.slots[slot].name, name) != 0))
+            slot = (slot + 1) % BusChannelDirectory::numSlots;
+
+        return slot;
+    }
+
+    static int findFreeNamedChannel(const BusChannelDirectory& directory) noexcept
+    {
+        for (int channelID = busNumberedChannels + 1; channelID <= busMaxChannelIDs; ++channelID)
+            if (directory.slotOfChannel[channelID - 1] == 0)
+                return channelID;
+
+        return 0;
+    }
+
+    // Empties a slot, moving later entries of the same probe run back so lookups never stop
+    // short at the hole
+    static void removeSlot(BusChannelDirectory& directory, int slot) noexcept
+    {
+        constexpr int numSlots = BusChannelDirectory::numSlots;
+
+        directory.slotOfChannel[directory.slots[slot].channelID - 1] = 0;
+
+        for (int i = (slot + 1) % numSlots; directory.slots[i].hash != 0; i = (i + 1) % numSlots)
+        {
+            // An entry whose home lies cyclically in (slot, i] can't move before it
+            const int home = (int)(directory.slots[i].hash % numSlots);
+
+            if (slot <= i ? (home > slot && home <= i) : (home > slot || home <= i))
+                continue;
+
+            directory.slots[slot] = directory.slots[i];
+            directory.slotOfChannel[directory.slots[slot].channelID - 1] = slot + 1;
+            slot = i;
+        }
+
+        directory.slots[slot] = {};
+    }
+
+    // Forgets the reader that last played a channel ID before it goes to another name
+    static void resetReaderSide(ChannelRingBuffer& channel) noexcept
+    {
+        channel.totalRead.store(0, std::memory_order_relaxed);
+        channel.readerSampleRate.store(0.0, std::memory_order_relaxed);
+        channel.readerBlockSize.store(0, std::memory_order_relaxed);
+        channel.readerNumChannels.store(0, std::memory_order_relaxed);
+        channel.readerTelemetry.timing.reset();
+        channel.readerTelemetry.underruns.store(0, std::memory_order_relaxed);
+        channel.readerTelemetry.staleReads.store(0, std::memory_order_relaxed);
+        channel.readerTelemetry.driftPpm.store(0.0f, std::memory_order_relaxed);
+    }
+
+    // Gives back the IDs of names nobody looked up within the lease whose channel has no
+    // writers, no reader calling in and no routes
+    void releaseUnusedNames() noexcept
+    {
+        auto& directory = sharedBuffer->directory;
+        const int64_t now = getMonotonicNanos();
+
+        lockDirectory();
+
+        for (int slot = 0; slot < BusChannelDirectory::numSlots;)
+        {
+            const auto& entry = directory.slots[slot];
+
+            if (entry.hash == 0 || now - entry.lastUsedNanos < BusChannelDirectory::leaseNanos
+                || isChannelInUse(entry.channelID, now))
+            {
+                ++slot;
+                continue;
+            }
+
+            DBG("BusShared: Releasing channel " << entry.channelID << " (\"" << entry.name << "\")");
+            removeSlot(directory, slot); // Another entry may have moved into this slot, so look again
+        }
+
+        unlockDirectory();
+    }
+
+    bool isChannelInUse(int channelID, int64_t now) noexcept
+    {
+        const auto& channel = sharedBuffer->channels[channelID - 1];
+
+        for (auto& lane : channel.lanes)
+            if (lane.state.load(std::memory_order_acquire) != SourceLane::laneFree)
+                return true;
+
+        const int64_t readerHeartbeat = channel.readerTelemetry.timing.heartbeatNanos.load(std::memory_order_relaxed);
+
+        if (readerHeartbeat != 0 && now - readerHeartbeat < BusChannelDirectory::leaseNanos)
+            return true;
+
+        bool routed = false;
+
+        lockRoutes();
+
+        for (auto& route : sharedBuffer->routes.routes)
+            routed = routed || route.fromChannel == channelID || route.toChannel == channelID;
+
+        unlockRoutes();
+        return routed;
+    }
+
+    // Drops the routes of hosts that died without removing them
+    void reapDeadRoutes() noexcept
+    {
+        auto& table = sharedBuffer->routes;
+        const uint32_t self = BusProcess::getCurrentId();
+        bool changed = false;
+
+        lockRoutes();
+
+        for (auto& route : table.routes)
+        {
+            if (route.fromChannel == 0 || route.processId == self || BusProcess::isAlive(route.processId))
+                continue;
+
+            DBG("BusShared: Dropping route from channel " << route.fromChannel << " to " << route.toChannel
+                << " of dead process " << (int)route.processId);
+            route = {};
+            changed = true;
+        }
+
+        if (changed)
+            rebuildRouteGraph(table);
+
+        unlockRoutes();
+    }
+
+    // First-fit run of free granules. Returns the byte offset in the pool.
+    uint64_t allocateFromPool(size_t numBytes) noexcept
+    {
+        auto& pool = sharedBuffer->header.pool;
+        const int needed = (int)((numBytes + BusPoolDirectory::granuleBytes - 1) / BusPoolDirectory::granuleBytes);
+        uint64_t result = invalidOffset;
+
+        lockPool();
+
+        for (int start = 0, run = 0; start + run < BusPoolDirectory::numGranules;)
+        {
+            const int g = start + run;
+
+            if (pool.usedGranules[g / 64] & ((uint64_t)1 << (g % 64)))
+            {
+                start = g + 1;
+                run = 0;
+                continue;
+            }
+
+            if (++run == needed)
+            {
+                for (int i = start; i < start + needed; ++i)
+                    pool.usedGranules[i / 64] |= (uint64_t)1 << (i % 64);
+
+                result = (uint64_t)start * BusPoolDirectory::granuleBytes;
+                pool.bytesInUse.fetch_add((uint64_t)needed * BusPoolDirectory::granuleBytes, std::memory_order_relaxed);
+                break;
+            }
+        }
+
+        unlockPool();
+        return result;
+    }
+
+    void freeToPool(uint64_t offset, size_t numBytes) noexcept
+    {
+        auto& pool = sharedBuffer->header.pool;
+        const int first = (int)(offset / BusPoolDirectory::granuleBytes);
+        const int count = (int)((numBytes + BusPoolDirectory::granuleBytes - 1) / BusPoolDirectory::granuleBytes);
+
+        // Give the pages back before anyone else can allocate them
+        segment.releasePages((size_t)(sharedBuffer->header.poolOffset + offset), (size_t)count * BusPoolDirectory::granuleBytes);
+
+        lockPool();
+
+        for (int i = first; i < first + count; ++i)
+            pool.usedGranules[i / 64] &= ~((uint64_t)1 << (i % 64));
+
+        pool.bytesInUse.fetch_sub((uint64_t)count * BusPoolDirectory::granuleBytes, std::memory_order_relaxed);
+        unlockPool();
+    }
+
+    static constexpr size_t getPoolOffset() noexcept
+    {
+        return (sizeof(BusSharedMemory) + BusPoolDirectory::granuleBytes - 1) / BusPoolDirectory::granuleBytes * BusPoolDirectory::granuleBytes;
+    }
+
+    BusShared()
+    {
+        const size_t segmentSize = getPoolOffset() + BusPoolDirectory::poolBytes;
+        const auto result = segment.open("BusAlpha5SharedMemory_V" + std::to_string(BusSharedHeader::layoutVersion), segmentSize);
+
+        if (result == SharedMemorySegment::OpenResult::failed || !segment.commitPages(0, getPoolOffset()))
+        {
+            statusMessage = "Shared memory unavailable";
+            segment.close();
+            return;
+        }
+
+        auto* memory = static_cast<BusSharedMemory*>(segment.getData());
+        auto& header = memory->header;
+
+        if (result == SharedMemorySegment::OpenResult::created)
+        {
+            // Freshly created segments are zero-filled by the OS
+            header.version = BusSharedHeader::layoutVersion;
+            header.segmentSize = segmentSize;
+            header.poolOffset = getPoolOffset();
+            header.magic.store(BusSharedHeader::magicValue, std::memory_order_release);
+            DBG("BusShared: Created NEW shared memory (Control: " << (int64_t)sizeof(BusSharedMemory) << " bytes, pool reserve: " << BUSALPHA5_POOL_MEGABYTES << " MB)");
+        }
+        else
+        {
+            // The creator may still be initialising the header - give it a moment
+            for (int attempt = 0; attempt < 100 && header.magic.load(std::memory_order_acquire) == 0; ++attempt)
+                juce::Thread::sleep(5);
+
+            if (header.magic.load(std::memory_order_acquire) != BusSharedHeader::magicValue
+                || header.version != BusSharedHeader::layoutVersion
+                || header.segmentSize != segmentSize)
+            {
+                DBG("BusShared: Existing shared memory has an incompatible layout (version " << (int)header.version << ")");
+                statusMessage = "Incompatible bus version running";
+                segment.close();
+                return;
+            }
+
+            DBG("BusShared: Opened EXISTING shared memory");
+        }
+
+        header.attachedProcesses.fetch_add(1, std::memory_order_relaxed);
+        sharedBuffer = memory;
+        statusMessage = "OK";
+
+        // A host that crashed earlier may have left lanes behind
+        reapDeadWriters();
+    }
+
+    ~BusShared()
+    {
+        if (sharedBuffer)
+            sharedBuffer->header.attachedProcesses.fetch_sub(1, std::memory_order_relaxed);
+
+        sharedBuffer = nullptr;
+        segment.close();
+        DBG("BusShared: Cleaned up shared memory");
+    }
+
+    BusShared(const BusShared&) = delete;
+    BusShared& operator=(const BusShared&) = delete;
+
+    SharedMemorySegment segment;
     BusSharedMemory* sharedBuffer = nullptr;
+    const char* statusMessage = "Not initialised";
 };
\ No newline at end of file
@@ -0,0 +1,294 @@
+#pragma once
+#include <JuceHeader.h>
+#include <string>
+
+#if JUCE_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+#include <cstdlib>
+#include <cstdio>
+
+// Windows names live in the per-session "Local\" namespace by default, which needs
+// no elevation. Define this to 1 to share across sessions (requires running as admin).
+#ifndef BUSALPHA5_GLOBAL_SHARED_MEMORY
+#define BUSALPHA5_GLOBAL_SHARED_MEMORY 0
+#endif
+
+// Process identity, for telling whether whoever left state in shared memory is still around
+struct BusProcess
+{
+    static uint32_t getCurrentId() noexcept
+    {
+#if JUCE_WINDOWS
+        return (uint32_t)GetCurrentProcessId();
+#else
+        return (uint32_t)getpid();
+#endif
+    }
+
+    static bool isAlive(uint32_t processId) noexcept
+    {
+#if JUCE_WINDOWS
+        HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)processId);
+
+        if (process == NULL)
+            return GetLastError() == ERROR_ACCESS_DENIED;
+
+        const bool running = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+        CloseHandle(process);
+        return running;
+#else
+        return kill((pid_t)processId, 0) == 0 || errno == EPERM;
+#endif
+    }
+};
+
+// Set BUSALPHA5_SESSION in the environment to give a group of hosts (e.g. one render
+// job) a private set of buses. Hosts only see each other when the values match.
+
+// A named, process-shared memory segment.
+// Windows: pagefile-backed CreateFileMapping. Linux/macOS: shm_open + ftruncate + mmap,
+// with the segment unlinked when the last attached process lets go of it.
+// The segment is only reserved up front; pages are committed as regions are put to use.
+class SharedMemorySegment
+{
+public:
+    enum class OpenResult { failed, created, attached };
+
+    SharedMemorySegment() = default;
+    ~SharedMemorySegment() { close(); }
+
+    // Opens the segment called baseName, creating it (zero-filled) if nobody has yet
+    OpenResult open(const std::string& baseName, size_t numBytes)
+    {
+        close();
+
+        std::string sessionName = baseName;
+
+        if (const char* session = std::getenv("BUSALPHA5_SESSION"))
+            sessionName += std::string("_") + session;
+
+#if JUCE_WINDOWS
+        const std::string name = std::string(BUSALPHA5_GLOBAL_SHARED_MEMORY ? "Global\\" : "Local\\") + sessionName;
+
+        hMapFile = CreateFileMappingA(
+            INVALID_HANDLE_VALUE,
+            NULL,
+            PAGE_READWRITE | SEC_RESERVE,
+            (DWORD)((uint64_t)numBytes >> 32),
+            (DWORD)((uint64_t)numBytes & 0xffffffff),
+            name.c_str()
+        );
+
+        if (hMapFile == NULL)
+        {
+            DBG("SharedMemorySegment: FAILED to create file mapping - Error: " << (int)GetLastError());
+            return OpenResult::failed;
+        }
+
+        const bool existed = (GetLastError() == ERROR_ALREADY_EXISTS);
+
+        data = MapViewOfFile(hMapFile, FILE_MAP_ALL_ACCESS, 0, 0, numBytes);
+
+        if (data == NULL)
+        {
+            DBG("SharedMemorySegment: FAILED to map view of file - Error: " << (int)GetLastError());
+            close();
+            return OpenResult::failed;
+        }
+
+        size = numBytes;
+        return existed ? OpenResult::attached : OpenResult::created;
+#else
+        // shm names are system-wide, so scope them to the user. macOS caps them at 31
+        // characters, so the segment goes by a hash of the name; the lock files keep it readable
+        const std::string scopedName = sessionName + "_" + std::to_string((unsigned)getuid());
+        shmName = makeShortName(scopedName);
+        const std::string lockBase = "/tmp/" + scopedName;
+
+        // The guard lock serialises create/attach/detach; the users lock is held shared
+        // for as long as we're attached, so "last one out" can be detected even after a crash.
+        guardFd = ::open((lockBase + ".guard").c_str(), O_RDWR | O_CREAT, 0600);
+        usersFd = ::open((lockBase + ".users").c_str(), O_RDWR | O_CREAT, 0600);
+
+        if (guardFd < 0 || usersFd < 0)
+        {
+            DBG("SharedMemorySegment: FAILED to open lock files for " << shmName);
+            close();
+            return OpenResult::failed;
+        }
+
+        flock(guardFd, LOCK_EX);
+        flock(usersFd, LOCK_SH);
+
+        bool created = true;
+        int fd = shm_open(shmName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+        if (fd < 0 && errno == EEXIST)
+        {
+            created = false;
+            fd = shm_open(shmName.c_str(), O_RDWR, 0600);
+        }
+
+        if (fd >= 0 && created && ftruncate(fd, (off_t)numBytes) != 0)
+        {
+            ::close(fd);
+            shm_unlink(shmName.c_str());
+            fd = -1;
+        }
+
+        struct stat info {};
+        if (fd >= 0 && (fstat(fd, &info) != 0 || (size_t)info.st_size < numBytes))
+        {
+            DBG("SharedMemorySegment: existing segment " << shmName << " is too small");
+            ::close(fd);
+            fd = -1;
+        }
+
+        if (fd >= 0)
+        {
+            void* mapped = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd); // The mapping keeps the segment alive
+
+            if (mapped != MAP_FAILED)
+            {
+                data = mapped;
+                size = numBytes;
+            }
+            else if (created)
+            {
+                shm_unlink(shmName.c_str());
+            }
+        }
+
+        flock(guardFd, LOCK_UN);
+
+        if (data == nullptr)
+        {
+            DBG("SharedMemorySegment: FAILED to open " << shmName << " - errno " << errno);
+            close();
+            return OpenResult::failed;
+        }
+
+        return created ? OpenResult::created : OpenResult::attached;
+#endif
+    }
+
+    void close() noexcept
+    {
+#if JUCE_WINDOWS
+        // The kernel destroys the mapping once the last handle is closed
+        if (data)
+            UnmapViewOfFile(data);
+        if (hMapFile)
+            CloseHandle(hMapFile);
+
+        hMapFile = NULL;
+#else
+        if (guardFd >= 0)
+            flock(guardFd, LOCK_EX);
+
+        if (data)
+            munmap(data, size);
+
+        if (usersFd >= 0)
+        {
+            flock(usersFd, LOCK_UN);
+
+            // Nobody else holds the users lock: we were the last process attached
+            if (data && flock(usersFd, LOCK_EX | LOCK_NB) == 0)
+            {
+                shm_unlink(shmName.c_str());
+                DBG("SharedMemorySegment: Last detach, unlinked " << shmName);
+                flock(usersFd, LOCK_UN);
+            }
+
+            ::close(usersFd);
+        }
+
+        if (guardFd >= 0)
+        {
+            flock(guardFd, LOCK_UN);
+            ::close(guardFd);
+        }
+
+        guardFd = -1;
+        usersFd = -1;
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    // Backs a byte range with real memory before first use. Call off the audio thread.
+    bool commitPages(size_t offset, size_t numBytes) noexcept
+    {
+        if (data == nullptr || offset + numBytes > size) return false;
+
+#if JUCE_WINDOWS
+        // Committing through any view commits the section pages for every process
+        return VirtualAlloc(static_cast<char*>(data) + offset, numBytes, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+        // tmpfs backs pages on first touch; ftruncate already sized the file
+        return true;
+#endif
+    }
+
+    // Hands a byte range's backing memory back to the OS. Contents read as zero afterwards
+    // on Linux; elsewhere the pages are only marked as discardable.
+    void releasePages(size_t offset, size_t numBytes) noexcept
+    {
+        if (data == nullptr || offset + numBytes > size) return;
+
+        char* start = static_cast<char*>(data) + offset;
+
+#if JUCE_WINDOWS
+        VirtualAlloc(start, numBytes, MEM_RESET, PAGE_READWRITE);
+#elif defined(MADV_REMOVE)
+        madvise(start, numBytes, MADV_REMOVE);
+#else
+        madvise(start, numBytes, MADV_DONTNEED);
+#endif
+    }
+
+    void* getData() const noexcept { return data; }
+    size_t getSize() const noexcept { return size; }
+
+private:
+#if !JUCE_WINDOWS
+    // "/BA5_" and the name's 64-bit FNV-1a hash in hex: 21 characters, whatever the session
+    static std::string makeShortName(const std::string& name)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (const char c : name)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 1099511628211ull;
+        }
+
+        char shortName[32];
+        std::snprintf(shortName, sizeof(shortName), "/BA5_%016llx", (unsigned long long)hash);
+        return shortName;
+    }
+
+    std::string shmName;
+    int guardFd = -1;
+    int usersFd = -1;
+#else
+    HANDLE hMapFile = NULL;
+#endif
+
+    void* data = nullptr;
+    size_t size = 0;
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,161 @@
+// ============================================================================
+// BusMonitor - live view of the bus telemetry in shared memory
+// ============================================================================
+// Attaches to the same segment as Channel Alpha 5 and Bus Alpha 5 (honouring
+// BUSALPHA5_SESSION) and prints the health every writer and reader publishes:
+// processBlock time against the block deadline, ring fill watermarks, underruns,
+// overruns, reads thrown away as stale, drift correction and how long ago each side last ran, plus the bus-to-bus
+// routes in the order audio flows through them. It never touches the channels, so it
+// can watch a production session without disturbing it.
+//
+// Usage: BusMonitor [--channel n|name] [--interval ms] [--count n] [--all]
+//   --channel n     only this channel, by number or name       (all)
+//   --interval ms   time between reports                       (1000)
+//   --count n       reports before exiting, 0 = until killed   (0)
+//   --all           also list channels nobody is using
+#include <JuceHeader.h>
+#include "../../BusAlpha5/Source/BusShared.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+struct Settings
+{
+    int channelID = 0; // 0 = all
+    const char* channelName = nullptr;
+    int intervalMs = 1000;
+    int count = 0;
+    bool showIdle = false;
+};
+
+// "12.3 ms" style age of a heartbeat, or "-" if the side never ran
+static void formatAge(char* text, size_t size, const BusTimingSnapshot& timing, int64_t now)
+{
+    const double seconds = timing.getSecondsSinceHeartbeat(now);
+
+    if (seconds < 0.0)
+        std::snprintf(text, size, "-");
+    else if (seconds < 1.0)
+        std::snprintf(text, size, "%.1f ms", seconds * 1.0e3);
+    else
+        std::snprintf(text, size, "%.1f s", seconds);
+}
+
+static void printChannel(int channelID, const BusChannelHealth& health, int64_t now)
+{
+    char age[32];
+    formatAge(age, sizeof(age), health.reader, now);
+
+    char name[BusChannelName::maxLength + 4] = {};
+    if (BusShared::getInstance().getChannelName(channelID, name + 2, sizeof(name) - 3))
+    {
+        name[0] = ' ';
+        name[1] = '"';
+        std::strcat(name, "\"");
+    }
+
+    std::printf("Ch %2d%s  writers %2d  reader %s @ %.0f Hz: cpu %5.1f%% peak %5.1f%%, last ran %s ago\n",
+        channelID, name, health.activeWriters, health.reader.heartbeatNanos != 0 ? "up" : "none",
+        health.readerFormat.sampleRate, health.reader.getLoad() * 100.0, health.reader.getPeakLoad() * 100.0, age);
+    std::printf("       fill %d-%d  underruns %u  overruns %u  stale %u  drift %+.1f ppm  read %lld\n",
+        health.fillLow, health.fillHigh, health.underruns, health.getOverruns(), health.staleReads,
+        health.driftPpm, (long long)health.totalRead);
+
+    for (int i = 0; i < ChannelRingBuffer::maxLanes; ++i)
+    {
+        const auto& lane = health.lanes[i];
+        if (!lane.active)
+            continue;
+
+        formatAge(age, sizeof(age), lane.writer, now);
+        std::printf("       lane %2d  pid %-7u writer %-5llu %6.0f Hz %2dch %+6.1f dB%s%s  fill %6d/%-6d overruns %-5u cpu %5.1f%% peak %5.1f%%  last ran %s ago%s\n",
+            i, lane.processId, (unsigned long long)lane.instanceId, lane.format.sampleRate, lane.format.numChannels,
+            juce::Decibels::gainToDecibels(lane.mix.gain, -60.0f), lane.mix.muted ? " M" : "  ", lane.mix.soloed ? " S" : "  ",
+            lane.fill, lane.capacity, lane.overruns,
+            lane.writer.getLoad() * 100.0, lane.writer.getPeakLoad() * 100.0, age, lane.stalled ? "  STALLED" : "");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--all") == 0) settings.showIdle = true;
+        else if (std::strcmp(argv[i], "--channel") == 0 && i + 1 < argc) settings.channelName = argv[++i];
+        else if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) settings.intervalMs = juce::jmax(10, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) settings.count = juce::jmax(0, std::atoi(argv[++i]));
+        else
+        {
+            std::printf("Usage: BusMonitor [--channel n|name] [--interval ms] [--count n] [--all]\n");
+            return 2;
+        }
+    }
+
+    auto& bus = BusShared::getInstance();
+
+    if (!bus.isInitialized())
+    {
+        std::printf("BusShared unavailable: %s\n", bus.getStatusMessage());
+        return 1;
+    }
+
+    if (settings.channelName != nullptr && (settings.channelID = bus.findNamedChannel(settings.channelName)) == 0)
+    {
+        std::printf("No channel named \"%s\"\n", settings.channelName);
+        return 1;
+    }
+
+    const char* session = std::getenv("BUSALPHA5_SESSION");
+    std::printf("Bus monitor (session %s), every %d ms\n", session != nullptr ? session : "default", settings.intervalMs);
+
+    for (int report = 0; settings.count == 0 || report < settings.count; ++report)
+    {
+        if (report > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(settings.intervalMs));
+
+        const int64_t now = BusShared::getMonotonicNanos();
+        int shown = 0;
+
+        std::printf("\n--- pool %.1f MB in use\n", (double)bus.getPoolBytesInUse() / (1024.0 * 1024.0));
+
+        BusRoute routes[BusRouteTable::maxRoutes];
+        const int numRoutes = bus.getRoutes(routes, BusRouteTable::maxRoutes);
+
+        for (int i = 0; i < numRoutes; ++i)
+            std::printf("route  ch %2d -> ch %2d  depth %d  +%.1f ms (ch %d path %.1f ms)  pid %u\n",
+                routes[i].fromChannel, routes[i].toChannel, bus.getChannelDepth(routes[i].fromChannel),
+                routes[i].latencySeconds * 1.0e3, routes[i].toChannel, bus.getPathLatencySeconds(routes[i].toChannel) * 1.0e3,
+                routes[i].processId);
+
+        // Upstream channels first
+        int schedule[busMaxChannelIDs];
+        bus.getSchedule(schedule);
+
+        for (int channelID : schedule)
+        {
+            if (settings.channelID != 0 && channelID != settings.channelID)
+                continue;
+
+            BusChannelHealth health;
+            if (!bus.getChannelHealth(channelID, health))
+                continue;
+
+            if (!settings.showIdle && settings.channelID == 0 && health.activeWriters == 0 && health.reader.heartbeatNanos == 0)
+                continue;
+
+            printChannel(channelID, health, now);
+            ++shown;
+        }
+
+        if (shown == 0)
+            std::printf("No channel in use\n");
+
+        std::fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,261 @@
+// ============================================================================
+// BusRingBenchmark - cross-core throughput of the bus ring control words
+// ============================================================================
+// Runs a producer and a consumer thread on two different cores, moving audio
+// blocks through a ring the same way Channel Alpha 5 and Bus Alpha 5 do:
+//   1. "packed"    - read and write positions on one cache line, no caching
+//                    (the pre-user-004 ChannelRingBuffer layout)
+//   2. "separated" - each index on its own 128-byte line, cached remote index
+//                    (the current SourceLane layout)
+//   3. "BusShared" - the real writeToChannel/readFromChannel path in shared memory,
+//                    on a private bus session unless BUSALPHA5_SESSION is set
+//
+// Usage: BusRingBenchmark [blockSize=64] [seconds=2] [producerCore=0] [consumerCore=1]
+#include <JuceHeader.h>
+#include "../../BusAlpha5/Source/BusShared.h"
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#if JUCE_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static void pinCurrentThreadToCore(int core)
+{
+#if JUCE_LINUX
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+    juce::ignoreUnused(core); // Left to the scheduler elsewhere
+#endif
+}
+
+// Old layout: both indices share a line, both sides load the other's index every block
+struct PackedRing
+{
+    static constexpr int capacity = 32768;
+
+    std::atomic<uint32_t> writePos{ 0 };
+    std::atomic<uint32_t> readPos{ 0 };
+    float samples[capacity];
+
+    bool push(const float* data, int numSamples) noexcept
+    {
+        const uint32_t w = writePos.load(std::memory_order_relaxed);
+        if (w + (uint32_t)numSamples - readPos.load(std::memory_order_acquire) > (uint32_t)capacity)
+            return false;
+
+        for (int i = 0; i < numSamples; ++i)
+            samples[(w + (uint32_t)i) & (capacity - 1)] = data[i];
+
+        writePos.store(w + (uint32_t)numSamples, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(float* data, int numSamples) noexcept
+    {
+        const uint32_t r = readPos.load(std::memory_order_relaxed);
+        if (writePos.load(std::memory_order_acquire) - r < (uint32_t)numSamples)
+            return false;
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = samples[(r + (uint32_t)i) & (capacity - 1)];
+
+        readPos.store(r + (uint32_t)numSamples, std::memory_order_release);
+        return true;
+    }
+};
+
+// New layout: producer and consumer lines apart, each side caches the other's index
+struct SeparatedRing
+{
+    static constexpr int capacity = 32768;
+
+    alignas(busCacheLineSize) std::atomic<uint32_t> writePos{ 0 };
+    uint32_t cachedReadPos = 0;
+
+    alignas(busCacheLineSize) std::atomic<uint32_t> readPos{ 0 };
+    uint32_t cachedWritePos = 0;
+
+    alignas(busCacheLineSize) float samples[capacity];
+
+    bool push(const float* data, int numSamples) noexcept
+    {
+        const uint32_t w = writePos.load(std::memory_order_relaxed);
+
+        if (w + (uint32_t)numSamples - cachedReadPos > (uint32_t)capacity)
+        {
+            cachedReadPos = readPos.load(std::memory_order_acquire);
+            if (w + (uint32_t)numSamples - cachedReadPos > (uint32_t)capacity)
+                return false;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            samples[(w + (uint32_t)i) & (capacity - 1)] = data[i];
+
+        writePos.store(w + (uint32_t)numSamples, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(float* data, int numSamples) noexcept
+    {
+        const uint32_t r = readPos.load(std::memory_order_relaxed);
+
+        if (cachedWritePos - r < (uint32_t)numSamples)
+        {
+            cachedWritePos = writePos.load(std::memory_order_acquire);
+            if (cachedWritePos - r < (uint32_t)numSamples)
+                return false;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = samples[(r + (uint32_t)i) & (capacity - 1)];
+
+        readPos.store(r + (uint32_t)numSamples, std::memory_order_release);
+        return true;
+    }
+};
+
+struct Settings
+{
+    int blockSize = 64;
+    double seconds = 2.0;
+    int producerCore = 0;
+    int consumerCore = 1;
+};
+
+// Producer pushes as fast as the ring allows for the test duration; returns samples/second
+template <typename Ring>
+static double runRing(const Settings& settings)
+{
+    auto ring = std::make_unique<Ring>();
+    std::atomic<bool> running{ true };
+    std::atomic<int64_t> consumed{ 0 };
+
+    std::thread consumer([&]
+    {
+        pinCurrentThreadToCore(settings.consumerCore);
+        std::vector<float> block((size_t)settings.blockSize);
+        int64_t count = 0;
+
+        while (running.load(std::memory_order_relaxed))
+            if (ring->pop(block.data(), settings.blockSize))
+                count += settings.blockSize;
+
+        consumed = count;
+    });
+
+    std::thread producer([&]
+    {
+        pinCurrentThreadToCore(settings.producerCore);
+        std::vector<float> block((size_t)settings.blockSize, 0.5f);
+
+        while (running.load(std::memory_order_relaxed))
+            ring->push(block.data(), settings.blockSize);
+    });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(settings.seconds));
+    running = false;
+    producer.join();
+    consumer.join();
+
+    return (double)consumed.load() / settings.seconds;
+}
+
+// Same shape through the real shared-memory lane. The writer never waits (like a host
+// callback), so the reader polls and we count what it actually received.
+static double runBusShared(const Settings& settings)
+{
+    auto& bus = BusShared::getInstance();
+    const int channelID = 32;
+
+    const auto writer = bus.registerWriter(channelID);
+    if (!bus.prepareWriter(writer, 48000.0, settings.blockSize))
+    {
+        std::printf("  BusShared unavailable: %s\n", bus.getStatusMessage());
+        bus.unregisterWriter(writer);
+        return 0.0;
+    }
+
+    std::atomic<bool> running{ true };
+    std::atomic<int64_t> consumed{ 0 };
+
+    std::thread consumer([&]
+    {
+        pinCurrentThreadToCore(settings.consumerCore);
+        std::vector<float> left((size_t)settings.blockSize), right((size_t)settings.blockSize);
+        int64_t count = 0;
+
+        while (running.load(std::memory_order_relaxed))
+        {
+            if (bus.getNumAvailable(channelID) < settings.blockSize)
+                continue;
+
+            bus.readFromChannel(channelID, left.data(), right.data(), settings.blockSize);
+            count += settings.blockSize;
+        }
+
+        consumed = count;
+    });
+
+    std::thread producer([&]
+    {
+        pinCurrentThreadToCore(settings.producerCore);
+        std::vector<float> left((size_t)settings.blockSize, 0.5f), right((size_t)settings.blockSize, -0.5f);
+
+        while (running.load(std::memory_order_relaxed))
+        {
+            // Stay within the ring so the comparison measures transport, not overruns
+            if (bus.getNumAvailable(channelID) + settings.blockSize <= BusShared::getRingCapacityFor(48000.0, settings.blockSize))
+                bus.writeToChannel(writer, left.data(), right.data(), settings.blockSize);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(settings.seconds));
+    running = false;
+    producer.join();
+    consumer.join();
+
+    bus.unregisterWriter(writer);
+    return (double)consumed.load() / settings.seconds;
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+
+    if (argc > 1) settings.blockSize = juce::jlimit(1, 4096, std::atoi(argv[1]));
+    if (argc > 2) settings.seconds = juce::jmax(0.1, std::atof(argv[2]));
+    if (argc > 3) settings.producerCore = std::atoi(argv[3]);
+    if (argc > 4) settings.consumerCore = std::atoi(argv[4]);
+
+    // A bus of our own, so a running session neither hears our blocks nor loses its own to us
+    if (std::getenv("BUSALPHA5_SESSION") == nullptr)
+    {
+        const std::string session = "ringbench-" + std::to_string(BusProcess::getCurrentId());
+       #if JUCE_WINDOWS
+        _putenv_s("BUSALPHA5_SESSION", session.c_str());
+       #else
+        setenv("BUSALPHA5_SESSION", session.c_str(), 1);
+       #endif
+    }
+
+    std::printf("Bus ring cross-core benchmark: block %d, %.1f s per run, cores %d -> %d\n",
+        settings.blockSize, settings.seconds, settings.producerCore, settings.consumerCore);
+
+    const double packed = runRing<PackedRing>(settings);
+    const double separated = runRing<SeparatedRing>(settings);
+    const double shared = runBusShared(settings);
+
+    std::printf("  packed indices     : %8.2f Msamples/s\n", packed / 1.0e6);
+    std::printf("  separated + cached : %8.2f Msamples/s  (%.2fx)\n", separated / 1.0e6, packed > 0.0 ? separated / packed : 0.0);
+    std::printf("  BusShared lane     : %8.2f Msamples/s  (stereo, %.0fx real time at 48 kHz)\n", shared / 1.0e6, shared / 48000.0);
+
+    return 0;
+}
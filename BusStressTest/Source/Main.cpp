@@ -0,0 +1,664 @@
+// ============================================================================
+// BusStressTest - multi-process qualification of the BusShared transport
+// ============================================================================
+// Starts N writer and M reader processes on one bus, the way several DAWs would
+// share it, and has them exchange test blocks at audio-callback cadence:
+//   - writers claim a lane each (spread over the channels) and send one block per
+//     period, woken late by a random jitter the way a loaded host is
+//   - readers split the channels between them and pull their own block size per
+//     period, either lane by lane (the Bus Alpha 5 path) or summed through
+//     readFromChannel (needs at most one writer per channel to stay checkable)
+//
+// Every block is a self-describing frame: a marker, the writer, a sequence number,
+// the send time and a checksum over the whole frame, followed by a pseudo-random
+// payload. Readers reassemble frames from whatever they pull and count:
+//   corrupt    frames whose checksum fails although no overrun happened meanwhile
+//   torn       frames whose checksum fails while a writer was overrunning the reader
+//   stale      reads thrown away because the writer overwrote them meanwhile (per-lane
+//              path only; see BusShared::isLaneDataIntact), so torn should stay at 0 there
+//   lost       frames skipped (sequence gaps), e.g. after an overrun or a resync
+//   underruns  reader callbacks that found a primed lane without a full block
+//   overruns   writer blocks written over audio the reader hadn't consumed
+// and measure end-to-end latency from the embedded send time.
+//
+// Usage: BusStressTest [options]
+//   --writers <n>       writer processes                              (32)
+//   --readers <n>       reader processes                              (4)
+//   --channels <n>      channels used, 1..32                          (32)
+//   --seconds <s>       test length                                   (10)
+//   --rate <Hz>         sample rate of every process                  (48000)
+//   --block <samples>   writer block size                             (256)
+//   --reader-block <n>  reader block size                             (512)
+//   --jitter <ms>       max extra delay of each callback              (1)
+//   --prime <ms>        audio a reader lets queue before playing a lane (20)
+//   --sum               read with readFromChannel instead of per lane
+// Exits 1 if any frame was corrupt, 0 otherwise.
+#include <JuceHeader.h>
+#include "../../BusAlpha5/Source/BusShared.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Settings
+{
+    int numWriters = 32;
+    int numReaders = 4;
+    int numChannels = 32;
+    double seconds = 10.0;
+    double sampleRate = 48000.0;
+    int writerBlock = 256;
+    int readerBlock = 512;
+    double jitterMs = 1.0;
+    double primeMs = 20.0;
+    bool sum = false;
+
+    // Set by the parent for its children
+    std::string role;
+    int index = 0;
+    int64_t startNanos = 0;
+};
+
+//==============================================================================
+// Test frames. Header fields are 16-bit integers stored as floats (exact), so they
+// survive the float ring untouched; the payload stays within [-1, 1).
+namespace Frame
+{
+    constexpr float marker = 4096.0f; // Never produced by the payload
+    enum Field { fieldMarker = 0, fieldWriter, fieldSequence, fieldTime = fieldSequence + 2, fieldLength = fieldTime + 4,
+                 fieldChecksum, headerSize = fieldChecksum + 2 };
+
+    inline uint32_t hash(uint32_t x) noexcept
+    {
+        x ^= x >> 16; x *= 0x7feb352dU;
+        x ^= x >> 15; x *= 0x846ca68bU;
+        x ^= x >> 16;
+        return x;
+    }
+
+    inline void putWord(float* header, int field, uint64_t value, int numWords) noexcept
+    {
+        for (int i = 0; i < numWords; ++i)
+            header[field + i] = (float)((value >> (16 * i)) & 0xffff);
+    }
+
+    inline uint64_t getWord(const float* header, int field, int numWords) noexcept
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < numWords; ++i)
+            value |= (uint64_t)header[field + i] << (16 * i);
+        return value;
+    }
+
+    // FNV-1a over the bit patterns of both channels, with the checksum slots counted as zero
+    inline uint32_t checksum(const float* left, const float* right, int length) noexcept
+    {
+        uint32_t sum = 2166136261U;
+
+        for (int i = 0; i < length; ++i)
+        {
+            const bool slot = i == fieldChecksum || i == fieldChecksum + 1;
+            uint32_t l, r;
+            std::memcpy(&l, left + i, sizeof(l));
+            std::memcpy(&r, right + i, sizeof(r));
+            sum = (sum ^ (slot ? 0U : l)) * 16777619U;
+            sum = (sum ^ r) * 16777619U;
+        }
+
+        return sum;
+    }
+
+    inline void write(float* left, float* right, int length, int writer, uint32_t sequence, int64_t timeNanos) noexcept
+    {
+        for (int i = headerSize; i < length; ++i)
+        {
+            const uint32_t h = hash(((uint32_t)writer << 24) ^ (sequence * 2654435761U) ^ (uint32_t)i);
+            left[i] = (float)(int32_t)(h & 0xffffff) / 8388608.0f - 1.0f;
+            right[i] = (float)(int32_t)(h >> 8) / 8388608.0f - 1.0f;
+        }
+
+        for (int i = 0; i < headerSize; ++i)
+            left[i] = right[i] = 0.0f;
+
+        left[fieldMarker] = marker;
+        putWord(left, fieldWriter, (uint64_t)writer, 1);
+        putWord(left, fieldSequence, sequence, 2);
+        putWord(left, fieldTime, (uint64_t)timeNanos, 4);
+        putWord(left, fieldLength, (uint64_t)length, 1);
+        putWord(left, fieldChecksum, checksum(left, right, length), 2);
+    }
+}
+
+//==============================================================================
+// Audio-callback cadence: one wake-up per period, each delayed by up to the jitter
+class Cadence
+{
+public:
+    Cadence(int64_t startNanos, double periodSeconds, double jitterMs, uint32_t seed)
+        : next(startNanos), period((int64_t)(periodSeconds * 1.0e9)),
+          jitter(0, (int64_t)(jitterMs * 1.0e6)), random(seed)
+    {
+    }
+
+    // Sleeps until the next callback is due and returns its nominal time
+    int64_t wait()
+    {
+        const int64_t due = next;
+        const int64_t wakeUp = due + (jitter.b() > 0 ? jitter(random) : 0);
+        next += period;
+
+        const int64_t now = BusShared::getMonotonicNanos();
+        if (wakeUp > now)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wakeUp - now));
+
+        return due;
+    }
+
+private:
+    int64_t next, period;
+    std::uniform_int_distribution<int64_t> jitter;
+    std::mt19937 random;
+};
+
+static int64_t getEndNanos(const Settings& settings)
+{
+    return settings.startNanos + (int64_t)(settings.seconds * 1.0e9);
+}
+
+// Writers linger this long after the end so readers can drain, readers stop halfway through it
+static constexpr int64_t drainNanos = 1000000000;
+
+static int getWriterChannel(const Settings& settings, int writer) { return 1 + writer % settings.numChannels; }
+static int getReaderOfChannel(const Settings& settings, int channelID) { return (channelID - 1) % settings.numReaders; }
+
+//==============================================================================
+static int runWriter(const Settings& settings)
+{
+    auto& bus = BusShared::getInstance();
+    const int channelID = getWriterChannel(settings, settings.index);
+    const auto writer = bus.registerWriter(channelID);
+
+    if (!writer.isValid() || !bus.prepareWriter(writer, settings.sampleRate, settings.writerBlock))
+    {
+        std::printf("ERROR writer %d: no lane on channel %d (%s)\n", settings.index, channelID, bus.getStatusMessage());
+        bus.unregisterWriter(writer);
+        return 1;
+    }
+
+    std::vector<float> left((size_t)settings.writerBlock), right((size_t)settings.writerBlock);
+    Cadence cadence(settings.startNanos, settings.writerBlock / settings.sampleRate, settings.jitterMs, 1000u + (uint32_t)settings.index);
+    const int64_t end = getEndNanos(settings);
+    uint32_t sequence = 0;
+
+    while (cadence.wait() < end)
+    {
+        Frame::write(left.data(), right.data(), settings.writerBlock, settings.index, sequence++, BusShared::getMonotonicNanos());
+        bus.writeToChannel(writer, left.data(), right.data(), settings.writerBlock);
+    }
+
+    std::this_thread::sleep_for(std::chrono::nanoseconds(drainNanos));
+    bus.unregisterWriter(writer);
+
+    std::printf("RESULT writer blocks=%u\n", sequence);
+    return 0;
+}
+
+//==============================================================================
+// What a reader has pulled from one stream (a lane, or a summed channel) and not parsed yet
+struct Stream
+{
+    std::vector<float> left, right;
+    int size = 0;
+    bool primed = false;
+    bool active = false;
+    uint32_t generation = 0;
+    uint32_t nextReadPos = 0;
+    std::vector<int64_t> nextSequence; // Per writer, -1 until its first frame
+
+    void reset(int numWriters)
+    {
+        size = 0;
+        primed = false;
+        nextSequence.assign((size_t)numWriters, -1);
+    }
+};
+
+struct ReaderStats
+{
+    int64_t frames = 0, samples = 0, corrupt = 0, torn = 0, stale = 0, lost = 0, underruns = 0, resyncs = 0;
+    std::vector<int64_t> latencyNanos;
+};
+
+class Reader
+{
+public:
+    explicit Reader(const Settings& s) : settings(s), bus(BusShared::getInstance())
+    {
+        const int streamCapacity = 4 * (settings.writerBlock + settings.readerBlock);
+
+        for (int channelID = 1; channelID <= settings.numChannels; ++channelID)
+            if (getReaderOfChannel(settings, channelID) == settings.index)
+                channels.push_back(channelID);
+
+        streams.resize(channels.size() * ChannelRingBuffer::maxLanes);
+        for (auto& stream : streams)
+        {
+            stream.left.resize((size_t)streamCapacity);
+            stream.right.resize((size_t)streamCapacity);
+            stream.reset(settings.numWriters);
+        }
+
+        left.resize((size_t)settings.readerBlock);
+        right.resize((size_t)settings.readerBlock);
+        primeSamples = juce::jmax(settings.readerBlock, (int)(settings.primeMs * 0.001 * settings.sampleRate));
+        stats.latencyNanos.reserve((size_t)(settings.seconds * settings.sampleRate / settings.writerBlock) * 2 + 1024);
+    }
+
+    int run()
+    {
+        for (auto channelID : channels)
+            bus.publishReaderFormat(channelID, settings.sampleRate, settings.readerBlock);
+
+        Cadence cadence(settings.startNanos, settings.readerBlock / settings.sampleRate, settings.jitterMs, 2000u + (uint32_t)settings.index);
+        const int64_t end = getEndNanos(settings) + drainNanos / 2;
+
+        while (cadence.wait() < end)
+            for (size_t c = 0; c < channels.size(); ++c)
+                settings.sum ? readSummed(c) : readLanes(c);
+
+        int64_t overruns = 0;
+        for (auto channelID : channels)
+            overruns += bus.getOverruns(channelID);
+
+        std::sort(stats.latencyNanos.begin(), stats.latencyNanos.end());
+        const auto percentile = [this](size_t p) -> double
+        {
+            if (stats.latencyNanos.empty()) return 0.0;
+            return (double)stats.latencyNanos[juce::jmin(stats.latencyNanos.size() - 1, stats.latencyNanos.size() * p / 100)] * 1.0e-6;
+        };
+
+        std::printf("RESULT reader frames=%lld samples=%lld corrupt=%lld torn=%lld stale=%lld lost=%lld underruns=%lld resyncs=%lld"
+                    " overruns=%lld p50=%.3f p99=%.3f max=%.3f\n",
+            (long long)stats.frames, (long long)stats.samples, (long long)stats.corrupt, (long long)stats.torn,
+            (long long)stats.stale, (long long)stats.lost, (long long)stats.underruns, (long long)stats.resyncs, (long long)overruns,
+            percentile(50), percentile(99), stats.latencyNanos.empty() ? 0.0 : (double)stats.latencyNanos.back() * 1.0e-6);
+        return 0;
+    }
+
+private:
+    // The Bus Alpha 5 path: every lane is paced and checked on its own
+    void readLanes(size_t channelIndex)
+    {
+        const int channelID = channels[channelIndex];
+        if (!bus.beginChannelRead(channelID))
+            return;
+
+        for (int laneIndex = 0; laneIndex < ChannelRingBuffer::maxLanes; ++laneIndex)
+        {
+            auto& stream = streams[channelIndex * ChannelRingBuffer::maxLanes + (size_t)laneIndex];
+            BusLaneStatus status;
+
+            if (!bus.getLaneStatus(channelID, laneIndex, status))
+            {
+                stream.active = false;
+                continue;
+            }
+
+            if (!stream.active || status.generation != stream.generation)
+            {
+                stream.reset(settings.numWriters);
+                stream.active = true;
+                stream.generation = status.generation;
+                stream.nextReadPos = status.readPos;
+            }
+
+            // getLaneStatus() skipped us ahead: the writer lapped us and what we had is gone
+            if (status.readPos != stream.nextReadPos)
+            {
+                stream.size = 0;
+                ++stats.resyncs;
+            }
+
+            if (!read(stream, status.available, [&](int n)
+                {
+                    // Only consume what the writer hadn't started overwriting by the time we were done
+                    bus.peekLane(channelID, laneIndex, left.data(), right.data(), n);
+                    if (!bus.isLaneDataIntact(channelID, laneIndex, status.readPos))
+                        return false;
+                    bus.consumeLane(channelID, laneIndex, n);
+                    return true;
+                }))
+            {
+                stream.nextReadPos = status.readPos;
+                continue;
+            }
+
+            stream.nextReadPos = status.readPos + (uint32_t)settings.readerBlock;
+            parse(stream, channelID);
+        }
+
+        bus.endChannelRead(channelID, settings.readerBlock);
+    }
+
+    // The summing path: the channel's single lane comes out of readFromChannel unchanged
+    void readSummed(size_t channelIndex)
+    {
+        const int channelID = channels[channelIndex];
+        auto& stream = streams[channelIndex * ChannelRingBuffer::maxLanes];
+
+        if (bus.getActiveWriters(channelID) == 0)
+        {
+            stream.reset(settings.numWriters);
+            return;
+        }
+
+        if (read(stream, bus.getNumAvailable(channelID), [&](int n) { bus.readFromChannel(channelID, left.data(), right.data(), n); return true; }))
+            parse(stream, channelID);
+    }
+
+    // Pulls one reader block into the stream if the lane is primed and has it. A pull that
+    // returns false got stale audio: it's dropped along with the partial frame it would finish.
+    template <typename PullFunction>
+    bool read(Stream& stream, int available, PullFunction&& pull)
+    {
+        if (!stream.primed)
+        {
+            if (available < primeSamples)
+                return false;
+            stream.primed = true;
+        }
+
+        // A host would play silence here and wait for the lane to fill up again
+        if (available < settings.readerBlock)
+        {
+            ++stats.underruns;
+            stream.primed = false;
+            return false;
+        }
+
+        if (!pull(settings.readerBlock))
+        {
+            stream.size = 0;
+            stream.primed = false;
+            ++stats.stale;
+            return false;
+        }
+
+        // Keep room for a frame that straddles reads; anything older that didn't parse is garbage
+        if (stream.size + settings.readerBlock > (int)stream.left.size())
+        {
+            stream.size = 0;
+            ++stats.resyncs;
+        }
+
+        std::copy(left.begin(), left.end(), stream.left.begin() + stream.size);
+        std::copy(right.begin(), right.end(), stream.right.begin() + stream.size);
+        stream.size += settings.readerBlock;
+        return true;
+    }
+
+    void parse(Stream& stream, int channelID)
+    {
+        const int64_t now = BusShared::getMonotonicNanos();
+        const int overruns = bus.getOverruns(channelID);
+        const bool overrunning = overruns != lastOverruns[channelID];
+        lastOverruns[channelID] = overruns;
+
+        int position = 0;
+        bool inGarbage = false;
+
+        while (stream.size - position >= Frame::headerSize)
+        {
+            const float* l = stream.left.data() + position;
+            const float* r = stream.right.data() + position;
+            const int length = (int)Frame::getWord(l, Frame::fieldLength, 1);
+            const int writer = (int)Frame::getWord(l, Frame::fieldWriter, 1);
+
+            if (l[Frame::fieldMarker] != Frame::marker || length < Frame::headerSize || length > settings.writerBlock
+                || writer >= settings.numWriters)
+            {
+                // Not at a frame start: skip to the next marker
+                if (!inGarbage)
+                    ++stats.resyncs;
+                inGarbage = true;
+                ++position;
+                continue;
+            }
+
+            inGarbage = false;
+
+            if (stream.size - position < length)
+                break;
+
+            if (Frame::checksum(l, r, length) != (uint32_t)Frame::getWord(l, Frame::fieldChecksum, 2))
+            {
+                ++(overrunning ? stats.torn : stats.corrupt);
+                position += length;
+                continue;
+            }
+
+            const auto sequence = (int64_t)Frame::getWord(l, Frame::fieldSequence, 2);
+            auto& expected = stream.nextSequence[(size_t)writer];
+
+            if (expected >= 0 && sequence > expected)
+                stats.lost += sequence - expected;
+
+            expected = sequence + 1;
+            stats.latencyNanos.push_back(now - (int64_t)Frame::getWord(l, Frame::fieldTime, 4));
+            ++stats.frames;
+            stats.samples += length;
+            position += length;
+        }
+
+        std::copy(stream.left.begin() + position, stream.left.begin() + stream.size, stream.left.begin());
+        std::copy(stream.right.begin() + position, stream.right.begin() + stream.size, stream.right.begin());
+        stream.size -= position;
+    }
+
+    const Settings& settings;
+    BusShared& bus;
+    std::vector<int> channels;
+    std::vector<Stream> streams;
+    std::vector<float> left, right;
+    int primeSamples = 0;
+    int lastOverruns[33] = {};
+    ReaderStats stats;
+};
+
+//==============================================================================
+static bool parseArguments(int argc, char* argv[], Settings& settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+
+        if (arg == "--sum") { settings.sum = true; continue; }
+        if (i + 1 >= argc) return false;
+
+        const char* value = argv[++i];
+
+        if (arg == "--writers") settings.numWriters = juce::jlimit(0, 32 * ChannelRingBuffer::maxLanes, std::atoi(value));
+        else if (arg == "--readers") settings.numReaders = juce::jlimit(1, 32, std::atoi(value));
+        else if (arg == "--channels") settings.numChannels = juce::jlimit(1, 32, std::atoi(value));
+        else if (arg == "--seconds") settings.seconds = juce::jmax(0.1, std::atof(value));
+        else if (arg == "--rate") settings.sampleRate = juce::jlimit(8000.0, 768000.0, std::atof(value));
+        else if (arg == "--block") settings.writerBlock = juce::jlimit((int)Frame::headerSize + 1, 8192, std::atoi(value));
+        else if (arg == "--reader-block") settings.readerBlock = juce::jlimit(1, 8192, std::atoi(value));
+        else if (arg == "--jitter") settings.jitterMs = juce::jmax(0.0, std::atof(value));
+        else if (arg == "--prime") settings.primeMs = juce::jmax(0.0, std::atof(value));
+        else if (arg == "--role") settings.role = value;
+        else if (arg == "--index") settings.index = std::atoi(value);
+        else if (arg == "--start") settings.startNanos = std::atoll(value);
+        else return false;
+    }
+
+    settings.numReaders = juce::jmin(settings.numReaders, settings.numChannels);
+    return true;
+}
+
+static std::string getCommonArguments(const Settings& settings)
+{
+    char text[512];
+    std::snprintf(text, sizeof(text),
+        " --writers %d --readers %d --channels %d --seconds %.3f --rate %.1f --block %d --reader-block %d"
+        " --jitter %.3f --prime %.3f --start %lld%s",
+        settings.numWriters, settings.numReaders, settings.numChannels, settings.seconds, settings.sampleRate,
+        settings.writerBlock, settings.readerBlock, settings.jitterMs, settings.primeMs,
+        (long long)settings.startNanos, settings.sum ? " --sum" : "");
+    return text;
+}
+
+static int64_t getField(const std::string& line, const char* key)
+{
+    const auto at = line.find(std::string(" ") + key + "=");
+    return at == std::string::npos ? 0 : std::atoll(line.c_str() + at + std::strlen(key) + 2);
+}
+
+static double getFieldDouble(const std::string& line, const char* key)
+{
+    const auto at = line.find(std::string(" ") + key + "=");
+    return at == std::string::npos ? 0.0 : std::atof(line.c_str() + at + std::strlen(key) + 2);
+}
+
+// Parent: starts the children, waits for them and adds up what they report
+static int runParent(const Settings& baseSettings)
+{
+    Settings settings = baseSettings;
+
+    if (settings.sum && settings.numWriters > settings.numChannels)
+    {
+        std::printf("--sum needs at most one writer per channel (%d writers, %d channels)\n", settings.numWriters, settings.numChannels);
+        return 2;
+    }
+
+    // Keep the segment alive for the whole run, so children never race to create or unlink it
+    auto& bus = BusShared::getInstance();
+    if (!bus.isInitialized())
+    {
+        std::printf("BusShared unavailable: %s\n", bus.getStatusMessage());
+        return 2;
+    }
+
+    // Leaves the children a second to start and attach before the first callback
+    settings.startNanos = BusShared::getMonotonicNanos() + 1000000000;
+
+    const auto executable = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getFullPathName().toStdString();
+    const auto common = getCommonArguments(settings);
+
+    struct Child { std::unique_ptr<juce::ChildProcess> process; bool isReader; };
+    std::vector<Child> children;
+
+    auto launch = [&](const char* role, int index)
+    {
+        const std::string command = "\"" + executable + "\" --role " + role + " --index " + std::to_string(index) + common;
+        Child child{ std::make_unique<juce::ChildProcess>(), std::strcmp(role, "reader") == 0 };
+
+        if (!child.process->start(command, juce::ChildProcess::wantStdOut))
+        {
+            std::printf("Couldn't start %s %d\n", role, index);
+            return false;
+        }
+
+        children.push_back(std::move(child));
+        return true;
+    };
+
+    std::printf("Bus stress test: %d writers, %d readers on %d channels, %.0f Hz, blocks %d/%d, jitter %.2f ms, %s path, %.1f s\n",
+        settings.numWriters, settings.numReaders, settings.numChannels, settings.sampleRate, settings.writerBlock,
+        settings.readerBlock, settings.jitterMs, settings.sum ? "readFromChannel" : "per-lane", settings.seconds);
+
+    bool started = true;
+    for (int i = 0; i < settings.numReaders; ++i) started = launch("reader", i) && started;
+    for (int i = 0; i < settings.numWriters; ++i) started = launch("writer", i) && started;
+
+    int64_t blocksSent = 0, frames = 0, samples = 0, corrupt = 0, torn = 0, stale = 0, lost = 0, underruns = 0, resyncs = 0, overruns = 0;
+    double p50 = 0.0, p99 = 0.0, maxLatency = 0.0;
+    int failedChildren = 0;
+
+    for (auto& child : children)
+    {
+        const std::string output = child.process->readAllProcessOutput().toStdString();
+        const auto resultAt = output.find("RESULT");
+
+        if (resultAt == std::string::npos || child.process->getExitCode() != 0)
+        {
+            ++failedChildren;
+            std::printf("  child failed: %s\n", output.c_str());
+            continue;
+        }
+
+        const std::string line = output.substr(resultAt);
+
+        if (!child.isReader)
+        {
+            blocksSent += getField(line, "blocks");
+            continue;
+        }
+
+        frames += getField(line, "frames");
+        samples += getField(line, "samples");
+        corrupt += getField(line, "corrupt");
+        torn += getField(line, "torn");
+        stale += getField(line, "stale");
+        lost += getField(line, "lost");
+        underruns += getField(line, "underruns");
+        resyncs += getField(line, "resyncs");
+        overruns += getField(line, "overruns");
+        p50 = juce::jmax(p50, getFieldDouble(line, "p50"));
+        p99 = juce::jmax(p99, getFieldDouble(line, "p99"));
+        maxLatency = juce::jmax(maxLatency, getFieldDouble(line, "max"));
+    }
+
+    std::printf("  frames sent       : %lld\n", (long long)blocksSent);
+    std::printf("  frames verified   : %lld (%.2f%%)\n", (long long)frames, blocksSent > 0 ? 100.0 * (double)frames / (double)blocksSent : 0.0);
+    std::printf("  throughput        : %.2f Msamples/s stereo (%.1f streams of real time)\n",
+        (double)samples / settings.seconds * 1.0e-6, (double)samples / settings.seconds / settings.sampleRate);
+    std::printf("  latency (worst reader) p50 %.3f ms, p99 %.3f ms, max %.3f ms\n", p50, p99, maxLatency);
+    std::printf("  underruns %lld, overruns %lld, lost frames %lld, resyncs %lld\n",
+        (long long)underruns, (long long)overruns, (long long)lost, (long long)resyncs);
+    std::printf("  corrupt frames %lld, torn by overruns %lld, stale reads dropped %lld\n",
+        (long long)corrupt, (long long)torn, (long long)stale);
+
+    if (!started || failedChildren > 0)
+    {
+        std::printf("FAIL: %d child processes failed\n", failedChildren);
+        return 1;
+    }
+
+    std::printf(corrupt > 0 ? "FAIL\n" : "PASS\n");
+    return corrupt > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::printf("Usage: BusStressTest [--writers n] [--readers n] [--channels n] [--seconds s] [--rate Hz]\n"
+                    "                     [--block n] [--reader-block n] [--jitter ms] [--prime ms] [--sum]\n");
+        return 2;
+    }
+
+    if (settings.role == "writer") return runWriter(settings);
+    if (settings.role == "reader") return Reader(settings).run();
+
+    // A bus of our own, so running hosts neither hear the test nor disturb it
+    if (std::getenv("BUSALPHA5_SESSION") == nullptr)
+    {
+        const std::string session = "stress-" + std::to_string(BusProcess::getCurrentId());
+       #if JUCE_WINDOWS
+        _putenv_s("BUSALPHA5_SESSION", session.c_str());
+       #else
+        setenv("BUSALPHA5_SESSION", session.c_str(), 1);
+       #endif
+    }
+
+    return runParent(settings);
+}
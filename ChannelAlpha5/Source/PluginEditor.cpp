@@ -23,6 +23,11 @@ ChannelAlpha2Editor::ChannelAlpha2Editor(ChannelAlpha2Processor& p)
     channelIDAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         processor.getAPVTS(), "channelID", channelIDSelector);
 
+    channelNameEditor.setTextToShowWhenEmpty("name", juce::Colours::grey);
+    channelNameEditor.setText(processor.getChannelName(), juce::dontSendNotification);
+    channelNameEditor.onReturnKey = channelNameEditor.onFocusLost = [this] { processor.setChannelName(channelNameEditor.getText()); };
+    addAndMakeVisible(channelNameEditor);
+
     panKnob.setSliderStyle(juce::Slider::RotaryVerticalDrag);
     panKnob.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
     panKnob.setRange(-1.0, 1.0, 0.01);
@@ -57,6 +62,11 @@ ChannelAlpha2Editor::ChannelAlpha2Editor(ChannelAlpha2Processor& p)
     busSendStatusLabel.setFont(juce::Font(10.0f, juce::Font::bold));
     addAndMakeVisible(busSendStatusLabel);
 
+    busHealthLabel.setJustificationType(juce::Justification::centred);
+    busHealthLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    busHealthLabel.setFont(juce::Font(9.0f));
+    addAndMakeVisible(busHealthLabel);
+
     // Button setup with parameter attachments
     selectButton.setButtonText("SEL");
     selectButton.setClickingTogglesState(true);
@@ -238,7 +248,10 @@ void ChannelAlpha2Editor::resized() {
 
     auto topArea = area.removeFromTop(80);
     channelLabel.setBounds(topArea.removeFromTop(20));
-    channelIDSelector.setBounds(topArea.removeFromTop(24).reduced(20, 0));
+    auto channelRow = topArea.removeFromTop(24).reduced(5, 0);
+    channelIDSelector.setBounds(channelRow.removeFromLeft(56));
+    channelRow.removeFromLeft(4);
+    channelNameEditor.setBounds(channelRow);
     panKnob.setBounds(topArea.reduced(40, 5));
 
     int columnWidth = 50;
@@ -263,6 +276,7 @@ void ChannelAlpha2Editor::resized() {
     busSendButton.setBounds(leftColumn.removeFromTop(buttonHeight));  // DEBUG: Bus send button
     leftColumn.removeFromTop(buttonSpacing);
     busSendStatusLabel.setBounds(leftColumn.removeFromTop(18));  // DEBUG: Status display
+    busHealthLabel.setBounds(leftColumn.removeFromTop(24));
 
     int faderHeight = middleColumn.getHeight() - 25;
     fader.setBounds(middleColumn.removeFromTop(faderHeight).reduced(10, 0));
@@ -303,13 +317,27 @@ void ChannelAlpha2Editor::timerCallback() {
     float faderDB = processor.getAPVTS().getRawParameterValue("fader")->load();
     levelDisplay.setText(juce::String(faderDB, 1) + " dB", juce::dontSendNotification);
 
+    // A name overrides the number; one the bus had no channel left for shows red
+    const bool named = processor.getChannelName().isNotEmpty();
+    channelIDSelector.setEnabled(!named);
+    if (named && !processor.isChannelNameResolved())
+        channelNameEditor.setColour(juce::TextEditor::outlineColourId, juce::Colours::red);
+    else
+        channelNameEditor.removeColour(juce::TextEditor::outlineColourId);
+
     // DEBUG: Update bus send status
     bool busSendEnabled = processor.isBusSendEnabled();
     int channelID = processor.getChannelID();
     int64_t totalWritten = BusShared::getInstance().getTotalWritten(channelID);
 
+    // The bus converts when it runs at another rate; say so, since it costs CPU and a little latency
+    const BusStreamFormat busFormat = BusShared::getInstance().getReaderFormat(channelID);
+    const bool busConverts = busFormat.isValid() && processor.getSampleRate() > 0.0
+        && std::abs(busFormat.sampleRate - processor.getSampleRate()) > 0.5;
+
     if (busSendEnabled && totalWritten > lastWriteCount) {
-        busSendStatusLabel.setText("Bus: ● ON", juce::dontSendNotification);
+        busSendStatusLabel.setText(busConverts ? "Bus: ● ON (SRC " + juce::String(busFormat.sampleRate / 1000.0, 1) + "k)"
+                                               : juce::String("Bus: ● ON"), juce::dontSendNotification);
         busSendStatusLabel.setColour(juce::Label::textColourId, juce::Colours::lime);
         lastWriteCount = totalWritten;
     }
@@ -321,4 +349,20 @@ void ChannelAlpha2Editor::timerCallback() {
         busSendStatusLabel.setText("Bus: OFF", juce::dontSendNotification);
         busSendStatusLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
     }
+
+    // Our lane's telemetry: how much of the block deadline we use, and blocks the bus missed
+    const BusWriterHandle writer = processor.getBusWriter();
+    BusChannelHealth health;
+
+    if (writer.isValid() && BusShared::getInstance().getChannelHealth(writer.channelID, health)) {
+        const BusLaneHealth& lane = health.lanes[writer.lane];
+        const double peakLoad = lane.writer.getPeakLoad();
+        busHealthLabel.setText("CPU " + juce::String(juce::roundToInt(peakLoad * 100.0)) + "%\nOvr " + juce::String((int)lane.overruns),
+                               juce::dontSendNotification);
+        busHealthLabel.setColour(juce::Label::textColourId, peakLoad > 0.8 ? juce::Colours::red
+                                                            : lane.overruns > 0 ? juce::Colours::orange : juce::Colours::grey);
+    }
+    else {
+        busHealthLabel.setText({}, juce::dontSendNotification);
+    }
 }
\ No newline at end of file
@@ -40,10 +40,12 @@ private:
 
     juce::Label channelLabel;
     juce::ComboBox channelIDSelector;
+    juce::TextEditor channelNameEditor;  // Named bus channel, used instead of the number when not empty
     juce::Slider panKnob;
     juce::Slider fader;
     juce::Label levelDisplay;
     juce::Label busSendStatusLabel;  // DEBUG: Shows bus send activity
+    juce::Label busHealthLabel;      // CPU load and overruns from the bus telemetry
     juce::TextButton selectButton;
     juce::TextButton autoRecButton;
     juce::TextButton soloButton;
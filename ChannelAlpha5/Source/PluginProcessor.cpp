@@ -3,7 +3,6 @@
 // ============================================================================
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "BusShared.h" // Include bus shared memory
 
 ChannelAlpha2Processor::ChannelAlpha2Processor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -17,33 +16,43 @@ ChannelAlpha2Processor::ChannelAlpha2Processor()
     muteGain.setCurrentAndTargetValue(1.0f);
     faderGain.setCurrentAndTargetValue(1.0f);
     panValue.setCurrentAndTargetValue(0.0f);
+    buildPanLawTables();
     // Initialize DDX3216 parameter smoothers
-    emuAmountSmoother.setCurrentAndTargetValue(1.0f);
-    preEmphasisSmoother.setCurrentAndTargetValue(0.0f);
-    harmonicsSmoother.setCurrentAndTargetValue(0.0f);
-    intersampleSmoother.setCurrentAndTargetValue(0.0f);
-    saturationSmoother.setCurrentAndTargetValue(0.25f);
-    noiseFloorSmoother.setCurrentAndTargetValue(-96.0f);
-    inputGainSmoother.setCurrentAndTargetValue(0.0f);
+    ddxParameters.setCurrentAndTargetValue(ddxEmuAmount, 1.0f);
+    ddxParameters.setCurrentAndTargetValue(ddxPreEmphasis, 0.0f);
+    ddxParameters.setCurrentAndTargetValue(ddxHarmonics, 0.0f);
+    ddxParameters.setCurrentAndTargetValue(ddxIntersample, 0.0f);
+    ddxParameters.setCurrentAndTargetValue(ddxSaturation, 0.25f);
+    ddxParameters.setCurrentAndTargetValue(ddxNoiseFloor, -96.0f);
+    ddxParameters.setCurrentAndTargetValue(ddxInputGain, 0.0f);
     // Track initial channel ID
     currentChannelID = getChannelID();
-    // Register with bus shared memory
-    BusShared::getInstance().registerWriter(currentChannelID);
+    // Register with bus shared memory (claims a lane of our own on the channel)
+    busWriter = BusShared::getInstance().registerWriter(currentChannelID);
     // Add parameter listener for channel ID changes
     apvts.addParameterListener(PARAM_CHANNEL_ID, this);
+    // And for oversampler setup changes
+    apvts.addParameterListener(PARAM_INTERSAMPLE_FACTOR, this);
+    apvts.addParameterListener(PARAM_INTERSAMPLE_QUALITY, this);
+    // Channel changes are carried out here, off the audio thread
+    startTimerHz(10);
 }
 
 ChannelAlpha2Processor::~ChannelAlpha2Processor() {
+    stopTimer();
     // Unregister from bus shared memory
-    BusShared::getInstance().unregisterWriter(currentChannelID);
+    BusShared::getInstance().unregisterWriter(busWriter.exchange({}));
     apvts.removeParameterListener(PARAM_CHANNEL_ID, this);
+    apvts.removeParameterListener(PARAM_INTERSAMPLE_FACTOR, this);
+    apvts.removeParameterListener(PARAM_INTERSAMPLE_QUALITY, this);
     oversampler.reset();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool ChannelAlpha2Processor::isBusesLayoutSupported(const BusesLayout& layouts) const {
-    // We support ONLY stereo
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Mono up to 16 channels (what a bus lane carries); only stereo gets pan and the DDX stages
+    const auto& out = layouts.getMainOutputChannelSet();
+    if (out.isDisabled() || out.size() > busMaxChannels)
         return false;
     // Input and output must match
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
@@ -69,6 +78,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout ChannelAlpha2Processor::crea
         "Pan",
         juce::NormalisableRange<float>(-1.0f, 1.0f, 0.01f),
         0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ PARAM_PAN_LAW, 1 },
+        "Pan Law",
+        juce::StringArray{ "-3 dB", "-4.5 dB", "-6 dB", "0 dB (linear)" },
+        panLawMinus3dB));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ PARAM_EMU_AMOUNT, 1 },
         "Emu Amount",
@@ -90,6 +104,19 @@ juce::AudioProcessorValueTreeState::ParameterLayout ChannelAlpha2Processor::crea
         "Intersample Mod",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
         0.0f));
+    // Oversampler setup: changing these rebuilds it and changes our latency, so they aren't automatable
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ PARAM_INTERSAMPLE_FACTOR, 1 },
+        "Intersample Oversampling",
+        juce::StringArray{ "2x", "4x", "8x" },
+        0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ PARAM_INTERSAMPLE_QUALITY, 1 },
+        "Intersample Filter",
+        juce::StringArray{ "IIR (low latency)", "FIR (linear phase)" },
+        0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ PARAM_NOISE_FLOOR, 1 },
         "Noise Floor",
@@ -128,6 +155,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout ChannelAlpha2Processor::crea
         juce::ParameterID{ PARAM_BUS_SEND_ENABLED, 1 },
         "Bus Send",
         true));
+    // Level on the bus mixer; applied bus-side together with our mute and solo
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ PARAM_BUS_SEND_LEVEL, 1 },
+        "Bus Send Level",
+        juce::NormalisableRange<float>(-60.0f, 10.0f, 0.1f, 2.0f),
+        0.0f,
+        juce::AudioParameterFloatAttributes().withLabel("dB")));
     return { params.begin(), params.end() };
 }
 
@@ -137,14 +171,11 @@ void ChannelAlpha2Processor::prepareToPlay(double sampleRate, int samplesPerBloc
     faderGain.reset(sampleRate, 0.05);
     panValue.reset(sampleRate, 0.05);
     // Smooth DDX3216 parameters
-    emuAmountSmoother.reset(sampleRate, 0.03);
-    preEmphasisSmoother.reset(sampleRate, 0.03);
-    harmonicsSmoother.reset(sampleRate, 0.03);
-    intersampleSmoother.reset(sampleRate, 0.03);
-    saturationSmoother.reset(sampleRate, 0.03);
-    noiseFloorSmoother.reset(sampleRate, 0.03);
-    inputGainSmoother.reset(sampleRate, 0.03);
+    ddxParameters.reset(sampleRate, 0.03);
     muteGain.setCurrentAndTargetValue(muted ? 0.0f : 1.0f);
+    panGainScratch.setSize(2, samplesPerBlock);
+    // The bus lane carries whatever layout the host gave us
+    busLayout = getChannelLayoutOfBus(false, 0);
     // Prepare EQ chains for exactly 2 channels (stereo)
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
@@ -152,26 +183,34 @@ void ChannelAlpha2Processor::prepareToPlay(double sampleRate, int samplesPerBloc
     preEQChain.prepare(spec);
     postEQChain.prepare(spec);
     // Initialize filters
-    *preEQChain.get<0>().coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+    *preEQChain.get<0>().state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
         static_cast<float>(sampleRate), 22.0f, 0.707f);
     // Warmth shelf (subtle low boost)
-    *preEQChain.get<1>().coefficients = *juce::dsp::IIR::Coefficients<float>::makeLowShelf(
+    *preEQChain.get<1>().state = *juce::dsp::IIR::Coefficients<float>::makeLowShelf(
         static_cast<float>(sampleRate), 180.0f, 0.65f, juce::Decibels::decibelsToGain(1.2f));
     // Air shelf (subtle high boost)
-    *preEQChain.get<2>().coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
+    *preEQChain.get<2>().state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
         static_cast<float>(sampleRate), 9500.0f, 0.75f, juce::Decibels::decibelsToGain(0.6f));
-    // Pre-emphasis will be set dynamically
-    *preEQChain.get<3>().coefficients = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
+    // Pre-emphasis will be set dynamically (this sizes its coefficient storage once)
+    *preEQChain.get<3>().state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
         static_cast<float>(sampleRate), 6000.0f, 1.0f, 1.0f);
+    const float preEmphasisOmega = juce::MathConstants<float>::twoPi * 6000.0f / static_cast<float>(sampleRate);
+    preEmphasisMinusTwoCos = -2.0f * std::cos(preEmphasisOmega);
+    preEmphasisAlpha = std::sin(preEmphasisOmega) / (2.0f * 1.0f); // Q = 1
+    appliedPreEmphasisDB = -1.0f;
+    updatePreEmphasisCoefficients(ddxParameters.getCurrentValue(ddxPreEmphasis) * 8.0f);
     // Post-EQ gentle tilt
-    *postEQChain.get<0>().coefficients = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
+    *postEQChain.get<0>().state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
         static_cast<float>(sampleRate), 12000.0f, 0.9f, juce::Decibels::decibelsToGain(-0.4f));
-    oversamplerPrepared = false;
+    for (auto& stage : ddxBiquadStates)
+        stage[0] = stage[1] = BiquadState{};
+    // Build the intersample oversampler now, not on the audio thread, and report its latency
+    prepareOversampler();
     // Initialize exactly 2 random generators for noise
     channelSeeds.clear();
     noiseHPFStates.clear();
     std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(noiseSeed != 0 ? noiseSeed : rd());
     std::uniform_int_distribution<uint32_t> dist(1, 0x7FFFFFFF);
     for (int i = 0; i < 2; ++i) {
         uint32_t seed = dist(gen);
@@ -183,23 +222,37 @@ void ChannelAlpha2Processor::prepareToPlay(double sampleRate, int samplesPerBloc
     float rc = 1.0f / (2.0f * 3.1415926535f * cutoff);
     float dt = 1.0f / static_cast<float>(sampleRate);
     noiseHPFCoeff = dt / (rc + dt);
+    noiseCounter = 0;
+    noiseScratch.setSize(2, samplesPerBlock);
+    // A channel change made before the host started us (or with no message loop) doesn't wait for the timer
+    if (busChannelPending.exchange(false))
+        switchBusChannel();
+    // Size our bus ring for this sample rate and block size (not while the timer is moving our lane)
+    const juce::ScopedLock busLock(busWriterLock);
+    busSampleRate = sampleRate;
+    busBlockSize = samplesPerBlock;
+    BusShared::getInstance().prepareWriter(busWriter.load(), busSampleRate, busBlockSize, busLayout);
 }
 
 void ChannelAlpha2Processor::releaseResources() {
     preEQChain.reset();
     postEQChain.reset();
-    if (oversampler && oversamplerPrepared) {
+    for (auto& stage : ddxBiquadStates)
+        stage[0] = stage[1] = BiquadState{};
+    if (oversampler) {
         oversampler->reset();
     }
+    latencyCompensation.reset();
     std::fill(noiseHPFStates.begin(), noiseHPFStates.end(), 0.0f);
 }
 
 void ChannelAlpha2Processor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
     juce::ScopedNoDenormals noDenormals;
+    const int64_t blockStartNanos = BusShared::getMonotonicNanos();
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    // Clear any output channels beyond 2 (stereo)
+    // Clear any output channels the input doesn't cover
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i) {
         buffer.clear(i, 0, buffer.getNumSamples());
     }
@@ -223,117 +276,350 @@ void ChannelAlpha2Processor::processBlock(juce::AudioBuffer<float>& buffer, juce
     faderGain.setTargetValue(juce::Decibels::decibelsToGain(rawFaderDB));
     panValue.setTargetValue(rawPan);
     muteGain.setTargetValue(muted ? 0.0f : 1.0f);
-    emuAmountSmoother.setTargetValue(rawEmuAmount);
-    preEmphasisSmoother.setTargetValue(apvts.getRawParameterValue(PARAM_PRE_EMPHASIS)->load());
-    harmonicsSmoother.setTargetValue(apvts.getRawParameterValue(PARAM_HARMONICS)->load());
-    intersampleSmoother.setTargetValue(apvts.getRawParameterValue(PARAM_INTERSAMPLE)->load());
-    noiseFloorSmoother.setTargetValue(apvts.getRawParameterValue(PARAM_NOISE_FLOOR)->load());
-    inputGainSmoother.setTargetValue(apvts.getRawParameterValue(PARAM_INPUT_GAIN)->load());
+    ddxParameters.setTargetValue(ddxEmuAmount, rawEmuAmount);
+    ddxParameters.setTargetValue(ddxPreEmphasis, apvts.getRawParameterValue(PARAM_PRE_EMPHASIS)->load());
+    ddxParameters.setTargetValue(ddxHarmonics, apvts.getRawParameterValue(PARAM_HARMONICS)->load());
+    ddxParameters.setTargetValue(ddxIntersample, apvts.getRawParameterValue(PARAM_INTERSAMPLE)->load());
+    ddxParameters.setTargetValue(ddxNoiseFloor, apvts.getRawParameterValue(PARAM_NOISE_FLOOR)->load());
+    ddxParameters.setTargetValue(ddxInputGain, apvts.getRawParameterValue(PARAM_INPUT_GAIN)->load());
 
     // Process panning and level
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-        float currentFader = faderGain.getNextValue(); // Advance smoother
-        float currentPan = panValue.getNextValue(); // Advance smoother
-        float currentMute = muteGain.getNextValue(); // Advance smoother
-        float totalGain = currentFader * currentMute;
-
-        // Stereo processing with constant power panning
-        if (buffer.getNumChannels() >= 2) {
-            float panAngle = (currentPan + 1.0f) * 0.25f * juce::MathConstants<float>::pi;
-            float leftPanGain = std::cos(panAngle);
-            float rightPanGain = std::sin(panAngle);
-            buffer.setSample(0, sample, buffer.getSample(0, sample) * totalGain * leftPanGain);
-            buffer.setSample(1, sample, buffer.getSample(1, sample) * totalGain * rightPanGain);
-        }
-    }
+    applyPanAndGain(buffer);
 
-    // Apply DDX3216 emulation if enabled (check RAW value)
-    if (ddxEmulation && rawEmuAmount > 0.001f) {
+    // Apply DDX3216 emulation if enabled (check RAW value); stereo layout only, on the first two channels
+    if (ddxEmulation && rawEmuAmount > 0.001f && busLayout.size() == 2) {
         processDDX3216(buffer);
     }
+    else {
+        applyLatencyCompensation(buffer);
+    }
 
-    // Add this section to your processBlock, right before the bus send:
-    // Write processed stereo audio to the bus for this channel if enabled
+    // Write processed audio to the bus for this channel if enabled, in our own layout
+    const BusWriterHandle writer = busWriter.load();
+    // Solo is in place across every strip on the bus channel, so the bus applies it (and level and mute)
+    BusLaneMix busMix;
+    busMix.gain = juce::Decibels::decibelsToGain(apvts.getRawParameterValue(PARAM_BUS_SEND_LEVEL)->load(), -60.0f);
+    busMix.muted = muted;
+    busMix.soloed = soloed;
+    BusShared::getInstance().setLaneMix(writer, busMix);
     if (busSendEnabled) {
-        int channelID = getChannelID();
-        // DEBUG: Log every 1000 blocks
-        static int debugCounter = 0;
-        if (++debugCounter >= 1000) {
-            debugCounter = 0;
-            DBG("Channel Alpha: Writing to channel " << channelID
-                << " | Samples: " << buffer.getNumSamples()
-                << " | L[0]: " << buffer.getSample(0, 0)
-                << " | R[0]: " << buffer.getSample(1, 0)
-                << " | Shared Mem OK: " << (BusShared::getInstance().isInitialized() ? "YES" : "NO"));
+        // Stamp the block with where it sits on our timeline so the bus can line up parallel stems
+        int64_t timelineSample = -1;
+        if (auto* playHead = getPlayHead()) {
+            if (auto position = playHead->getPosition()) {
+                if (position->getIsPlaying() && position->getTimeInSamples().hasValue())
+                    timelineSample = *position->getTimeInSamples() - getLatencySamples(); // Our output lags the input
+            }
         }
         BusShared::getInstance().writeToChannel(
-            channelID,
-            buffer.getReadPointer(0),               // Left channel
-            buffer.getNumChannels() >= 2 ? buffer.getReadPointer(1) : nullptr, // Right channel
-            buffer.getNumSamples()
+            writer,
+            buffer.getArrayOfReadPointers(),
+            juce::jmin(buffer.getNumChannels(), busLayout.size()),
+            buffer.getNumSamples(),
+            timelineSample
         );
     }
+
+    // Processing time and heartbeat for the bus editors and BusMonitor
+    BusShared::getInstance().publishWriterTiming(writer, blockStartNanos, buffer.getNumSamples());
 }
 
 // Handle parameter changes for channel ID switching
-void ChannelAlpha2Processor::parameterChanged(const juce::String& parameterID, float newValue)
+void ChannelAlpha2Processor::parameterChanged(const juce::String& parameterID, float)
 {
     if (parameterID == PARAM_CHANNEL_ID)
     {
-        int newChannelID = static_cast<int>(newValue);
-        // Unregister from old channel and register to new channel
-        if (newChannelID != currentChannelID)
+        // Automation calls this on the audio thread, where moving lanes can't happen: leave it to the timer
+        busChannelPending = true;
+    }
+    else if (parameterID == PARAM_INTERSAMPLE_FACTOR || parameterID == PARAM_INTERSAMPLE_QUALITY)
+    {
+        // Rebuilding allocates and swaps the oversampler, so hold the audio thread off meanwhile
+        if (busSampleRate > 0.0)
         {
-            BusShared::getInstance().unregisterWriter(currentChannelID);
-            BusShared::getInstance().registerWriter(newChannelID);
-            currentChannelID = newChannelID;
+            suspendProcessing(true);
+            prepareOversampler();
+            suspendProcessing(false);
         }
     }
 }
 
+void ChannelAlpha2Processor::buildPanLawTables() {
+    for (int i = 0; i <= panTableSize; ++i) {
+        const float x = static_cast<float>(i) / panTableSize;
+        const float constantPower = std::cos(x * juce::MathConstants<float>::halfPi); // -3 dB at centre
+        const float linear = 1.0f - x;                                                  // -6 dB at centre
+        panLawTables[panLawMinus3dB][i] = constantPower;
+        panLawTables[panLawMinus4p5dB][i] = std::sqrt(constantPower * linear);       // Halfway between the two
+        panLawTables[panLawMinus6dB][i] = linear;
+        panLawTables[panLaw0dB][i] = juce::jmin(1.0f, 2.0f * linear);                // Balance: centre untouched
+    }
+}
+
+inline float ChannelAlpha2Processor::lookupPanGain(const std::array<float, panTableSize + 1>& table, float position) const {
+    const float index = juce::jlimit(0.0f, 1.0f, position) * panTableSize;
+    const int i = juce::jmin(panTableSize - 1, static_cast<int>(index));
+    return table[i] + (index - i) * (table[i + 1] - table[i]);
+}
+
+void ChannelAlpha2Processor::applyPanAndGain(juce::AudioBuffer<float>& buffer) {
+    const int numSamples = buffer.getNumSamples();
+    // A stereo strip pans the first two channels, however wide the host's buffer is
+    if (busLayout.size() != 2 || buffer.getNumChannels() < 2) {
+        applyGainOnly(buffer);
+        return;
+    }
+    const int law = juce::jlimit(0, numPanLaws - 1, static_cast<int>(apvts.getRawParameterValue(PARAM_PAN_LAW)->load()));
+    const auto& table = panLawTables[law];
+    float* left = buffer.getWritePointer(0);
+    float* right = buffer.getWritePointer(1);
+
+    // Settled: one gain per channel for the whole block
+    if (!faderGain.isSmoothing() && !panValue.isSmoothing() && !muteGain.isSmoothing()) {
+        const float totalGain = faderGain.getCurrentValue() * muteGain.getCurrentValue();
+        const float position = (panValue.getCurrentValue() + 1.0f) * 0.5f;
+        juce::FloatVectorOperations::multiply(left, totalGain * lookupPanGain(table, position), numSamples);
+        juce::FloatVectorOperations::multiply(right, totalGain * lookupPanGain(table, 1.0f - position), numSamples);
+        return;
+    }
+
+    // Ramping: build the per-sample gain curves, then apply them in one vector pass per channel
+    const int scratchSize = panGainScratch.getNumSamples();
+    float* leftGains = panGainScratch.getWritePointer(0);
+    float* rightGains = panGainScratch.getWritePointer(1);
+    for (int start = 0; start < numSamples && scratchSize > 0; start += scratchSize) {
+        const int length = juce::jmin(scratchSize, numSamples - start);
+        for (int i = 0; i < length; ++i) {
+            const float totalGain = faderGain.getNextValue() * muteGain.getNextValue();
+            const float position = (panValue.getNextValue() + 1.0f) * 0.5f;
+            leftGains[i] = totalGain * lookupPanGain(table, position);
+            rightGains[i] = totalGain * lookupPanGain(table, 1.0f - position);
+        }
+        juce::FloatVectorOperations::multiply(left + start, leftGains, length);
+        juce::FloatVectorOperations::multiply(right + start, rightGains, length);
+    }
+}
+
+void ChannelAlpha2Processor::applyGainOnly(juce::AudioBuffer<float>& buffer) {
+    // Mono and multichannel: fader and mute on every channel, nothing to pan
+    const int numSamples = buffer.getNumSamples();
+    panValue.skip(numSamples);
+    if (!faderGain.isSmoothing() && !muteGain.isSmoothing()) {
+        buffer.applyGain(faderGain.getCurrentValue() * muteGain.getCurrentValue());
+        return;
+    }
+    const int scratchSize = panGainScratch.getNumSamples();
+    float* gains = panGainScratch.getWritePointer(0);
+    for (int start = 0; start < numSamples && scratchSize > 0; start += scratchSize) {
+        const int length = juce::jmin(scratchSize, numSamples - start);
+        for (int i = 0; i < length; ++i)
+            gains[i] = faderGain.getNextValue() * muteGain.getNextValue();
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch) + start, gains, length);
+    }
+}
+
 void ChannelAlpha2Processor::processDDX3216(juce::AudioBuffer<float>& buffer) {
+    if (buffer.getNumChannels() < 2) return;
+    if (useReferenceDDXPath) {
+        processDDX3216Reference(buffer);
+        return;
+    }
+    // The tiles advance the parameter ramps; the intersample pass replays them from here
+    const DDXParameterBank blockStart = ddxParameters;
+
+    // One instantiation per combination of stages, indexed saturation | harmonics << 1 | noise << 2
+    using TileProcessor = void (ChannelAlpha2Processor::*)(float*, float*, int, DDXStageSettings);
+    static constexpr TileProcessor tileProcessors[8] = {
+        &ChannelAlpha2Processor::processDDXTiles<false, false, false>,
+        &ChannelAlpha2Processor::processDDXTiles<true, false, false>,
+        &ChannelAlpha2Processor::processDDXTiles<false, true, false>,
+        &ChannelAlpha2Processor::processDDXTiles<true, true, false>,
+        &ChannelAlpha2Processor::processDDXTiles<false, false, true>,
+        &ChannelAlpha2Processor::processDDXTiles<true, false, true>,
+        &ChannelAlpha2Processor::processDDXTiles<false, true, true>,
+        &ChannelAlpha2Processor::processDDXTiles<true, true, true>
+    };
+    // Settled: the stage set is known for the whole block. Ramping: any stage may switch on
+    // or off between tiles, so take the instantiation that has them all
+    const DDXStageSettings settings = makeDDXStageSettings(ddxParameters);
+    const int variant = ddxParameters.isSmoothing() ? 7
+        : (settings.saturation ? 1 : 0) | (settings.harmonics ? 2 : 0) | (settings.noise ? 4 : 0);
+    (this->*tileProcessors[variant])(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples(), settings);
+
+    // Intersample modulation runs at the oversampled rate, so it stays a pass of its own
+    applyIntersampleModulation(buffer, blockStart);
+}
+
+template <bool withSaturation, bool withHarmonics, bool withNoise>
+void ChannelAlpha2Processor::processDDXTiles(float* left, float* right, int numSamples, DDXStageSettings settings) {
+    const float* preEQCoefficients[4] = {
+        preEQChain.get<0>().state->getRawCoefficients(),
+        preEQChain.get<1>().state->getRawCoefficients(),
+        preEQChain.get<2>().state->getRawCoefficients(),
+        preEQChain.get<3>().state->getRawCoefficients()
+    };
+    const float* postEQCoefficients = postEQChain.get<0>().state->getRawCoefficients();
+
+    // The reference runs the pre-EQ in pre-emphasis sub-blocks while gliding, else in one go;
+    // the biquad states are snapped at the end of each of those runs, so we do the same
+    const bool ramping = ddxParameters.isSmoothing();
+    const bool gliding = ddxParameters.isSmoothing(ddxPreEmphasis);
+    if (!gliding)
+        updatePreEmphasisCoefficients(ddxParameters.getCurrentValue(ddxPreEmphasis) * 8.0f); // No-op unless it moved
+
+    for (int start = 0; start < numSamples; start += ddxTileSize) {
+        const int length = juce::jmin(ddxTileSize, numSamples - start);
+        float* l = left + start;
+        float* r = right + start;
+        if (ramping) {
+            ddxParameters.advance(length);
+            settings = makeDDXStageSettings(ddxParameters);
+            if (gliding)
+                updatePreEmphasisCoefficients(ddxParameters.getCurrentValue(ddxPreEmphasis) * 8.0f); // 0-8dB boost
+        }
+        for (int stage = 0; stage < 4; ++stage)
+            processStereoBiquad(preEQCoefficients[stage], ddxBiquadStates[stage], l, r, length);
+        if (gliding)
+            snapDDXBiquadStates(0, 4);
+        if constexpr (withSaturation) {
+            if (settings.saturation)
+                saturateRange(l, r, length, settings);
+        }
+        if constexpr (withHarmonics) {
+            if (settings.harmonics)
+                harmonicsRange(l, r, length, settings);
+        }
+        if constexpr (withNoise) {
+            if (settings.noise)
+                noiseRange(l, r, length, settings);
+        }
+        processStereoBiquad(postEQCoefficients, ddxBiquadStates[4], l, r, length);
+    }
+
+    snapDDXBiquadStates(gliding ? 4 : 0, numDDXBiquads);
+}
+
+inline void ChannelAlpha2Processor::processStereoBiquad(const float* coefficients, BiquadState* states, float* left, float* right, int numSamples) noexcept {
+    // Transposed direct form II, operation for operation as IIR::Filter's second-order case
+    const float b0 = coefficients[0], b1 = coefficients[1], b2 = coefficients[2];
+    const float a1 = coefficients[3], a2 = coefficients[4];
+    float l1 = states[0].s1, l2 = states[0].s2;
+    float r1 = states[1].s1, r2 = states[1].s2;
+    for (int i = 0; i < numSamples; ++i) {
+        const float inL = left[i];
+        const float outL = (inL * b0) + l1;
+        left[i] = outL;
+        l1 = (inL * b1) - (outL * a1) + l2;
+        l2 = (inL * b2) - (outL * a2);
+        const float inR = right[i];
+        const float outR = (inR * b0) + r1;
+        right[i] = outR;
+        r1 = (inR * b1) - (outR * a1) + r2;
+        r2 = (inR * b2) - (outR * a2);
+    }
+    states[0] = { l1, l2 };
+    states[1] = { r1, r2 };
+}
+
+void ChannelAlpha2Processor::snapDDXBiquadStates(int first, int last) noexcept {
+    for (int stage = first; stage < last; ++stage) {
+        for (auto& state : ddxBiquadStates[stage]) {
+            JUCE_SNAP_TO_ZERO(state.s1);
+            JUCE_SNAP_TO_ZERO(state.s2);
+        }
+    }
+}
+
+void ChannelAlpha2Processor::processDDX3216Reference(juce::AudioBuffer<float>& buffer) {
     if (buffer.getNumChannels() < 2) return;
     juce::dsp::AudioBlock<float> block(buffer);
     // Ensure we only process 2 channels
     if (block.getNumChannels() > 2) {
         block = block.getSubsetChannelBlock(0, 2);
     }
-    // Advance smoothers ONCE per block
-    float currentEmuAmount = emuAmountSmoother.getNextValue();
-    float currentPreEmphasis = preEmphasisSmoother.getNextValue();
-    float currentHarmonics = harmonicsSmoother.getNextValue();
-    float currentIntersample = intersampleSmoother.getNextValue();
-    float currentNoiseFloor = noiseFloorSmoother.getNextValue();
-    float currentInputGain = inputGainSmoother.getNextValue();
-    float currentSaturation = saturationSmoother.getNextValue();
-
-    // Apply pre-emphasis filter (based on knob)
-    float preEmphasisGainDB = currentPreEmphasis * 8.0f; // 0-8dB boost
-    *preEQChain.get<3>().coefficients = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        spec.sampleRate, 6000.0f, 1.0f, juce::Decibels::decibelsToGain(preEmphasisGainDB));
+    // Every pass below replays the parameter ramps over the block from here
+    const DDXParameterBank blockStart = ddxParameters;
+    const bool ramping = blockStart.isSmoothing();
 
     // Apply pre-EQ chain (HPF, warmth, air, pre-emphasis)
     juce::dsp::ProcessContextReplacing<float> ctx(block);
-    preEQChain.process(ctx);
+    if (blockStart.isSmoothing(ddxPreEmphasis)) {
+        // Knob is gliding: step the pre-emphasis coefficients every few samples so it doesn't zipper
+        DDXParameterBank parameters = blockStart;
+        const size_t numSamples = block.getNumSamples();
+        for (size_t start = 0; start < numSamples; start += preEmphasisSubBlock) {
+            const size_t length = juce::jmin((size_t)preEmphasisSubBlock, numSamples - start);
+            parameters.advance((int)length);
+            updatePreEmphasisCoefficients(parameters.getCurrentValue(ddxPreEmphasis) * 8.0f); // 0-8dB boost
+            auto subBlock = block.getSubBlock(start, length);
+            juce::dsp::ProcessContextReplacing<float> subCtx(subBlock);
+            preEQChain.process(subCtx);
+        }
+    }
+    else {
+        updatePreEmphasisCoefficients(blockStart.getCurrentValue(ddxPreEmphasis) * 8.0f); // No-op unless it moved
+        preEQChain.process(ctx);
+    }
+
+    float* left = buffer.getWritePointer(0);
+    float* right = buffer.getWritePointer(1);
+    const int numSamples = buffer.getNumSamples();
+
+    // Runs one stage over the whole block, with the settings of each sub-block while ramping
+    auto runStage = [&](auto&& stage) {
+        DDXParameterBank parameters = blockStart;
+        DDXStageSettings settings = makeDDXStageSettings(parameters);
+        if (!ramping) {
+            stage(left, right, numSamples, settings);
+            return parameters;
+        }
+        for (int start = 0; start < numSamples; start += preEmphasisSubBlock) {
+            const int length = juce::jmin(preEmphasisSubBlock, numSamples - start);
+            parameters.advance(length);
+            settings = makeDDXStageSettings(parameters);
+            stage(left + start, right + start, length, settings);
+        }
+        return parameters;
+    };
 
     // Apply saturation (scaled by emulation amount)
-    applySaturation(buffer, currentSaturation * currentEmuAmount);
+    runStage([this](float* l, float* r, int n, const DDXStageSettings& settings) {
+        if (settings.saturation) saturateRange(l, r, n, settings);
+    });
 
     // Apply harmonics (if knob is turned up)
-    if (currentHarmonics > 0.001f) {
-        applyHarmonics(buffer, currentHarmonics);
-    }
+    runStage([this](float* l, float* r, int n, const DDXStageSettings& settings) {
+        if (settings.harmonics) harmonicsRange(l, r, n, settings);
+    });
 
     // Apply noise (affected by noise floor and input gain knobs)
-    applyNoise(buffer, currentNoiseFloor, currentInputGain, currentEmuAmount);
+    ddxParameters = runStage([this](float* l, float* r, int n, const DDXStageSettings& settings) {
+        if (settings.noise) noiseRange(l, r, n, settings);
+    });
 
     // Apply post-EQ (gentle tilt)
     postEQChain.process(ctx);
 
-    // Apply intersample modulation (if knob is turned up)
-    if (currentIntersample > 0.001f) {
-        applyIntersampleModulation(buffer, currentIntersample);
-    }
+    // Apply intersample modulation. It always goes through the oversampler, even with the knob
+    // down, so the latency stays what we reported and turning the knob up doesn't jump.
+    applyIntersampleModulation(buffer, blockStart);
+}
+
+void ChannelAlpha2Processor::updatePreEmphasisCoefficients(float gainDB) noexcept {
+    if (gainDB == appliedPreEmphasisDB) return;
+    appliedPreEmphasisDB = gainDB;
+    // Same RBJ peak as IIR::Coefficients::makePeakFilter, normalised by a0, without the allocation
+    const float A = std::pow(10.0f, gainDB / 40.0f);
+    const float alphaTimesA = preEmphasisAlpha * A;
+    const float alphaOverA = preEmphasisAlpha / A;
+    const float a0Inverse = 1.0f / (1.0f + alphaOverA);
+    float* c = preEQChain.get<3>().state->getRawCoefficients();
+    c[0] = (1.0f + alphaTimesA) * a0Inverse;
+    c[1] = preEmphasisMinusTwoCos * a0Inverse;
+    c[2] = (1.0f - alphaTimesA) * a0Inverse;
+    c[3] = preEmphasisMinusTwoCos * a0Inverse;
+    c[4] = (1.0f - alphaOverA) * a0Inverse;
 }
 
 inline float ChannelAlpha2Processor::fastTanh(float x) const {
@@ -342,92 +628,143 @@ inline float ChannelAlpha2Processor::fastTanh(float x) const {
 }
 
 inline float ChannelAlpha2Processor::softClip(float x) const {
-    if (x > 1.0f) return 1.0f - (1.0f / (3.0f * x * x));
-    if (x < -1.0f) return -1.0f + (1.0f / (3.0f * x * x));
-    return x - (x * x * x) / 3.0f;
+    // x - x^3/3 inside [-1, 1], +-(1 - 1/(3x^2)) outside, written without selects so the stage
+    // loops vectorise: the cubic runs on x clamped to [-1, 1] and the outer tail is added on top
+    // (it is exactly zero inside). The clamp and max(x^2, 1) use the |a - b| identities.
+    const float clamped = 0.5f * (std::abs(x + 1.0f) - std::abs(x - 1.0f));
+    const float x2 = x * x;
+    const float x2AtLeastOne = 0.5f * (x2 + 1.0f + std::abs(x2 - 1.0f));
+    return clamped - (clamped * clamped * clamped) / 3.0f
+        + std::copysign(1.0f / 3.0f - 1.0f / (3.0f * x2AtLeastOne), x);
 }
 
 inline float ChannelAlpha2Processor::hardClip(float x, float threshold) const {
-    return juce::jlimit(-threshold, threshold, x);
+    const float lowered = x < -threshold ? -threshold : x;
+    return lowered > threshold ? threshold : lowered;
 }
 
-inline float ChannelAlpha2Processor::generateWhiteNoise(uint32_t& seed) const {
-    seed = seed * 1664525u + 1013904223u;
-    int32_t signedSeed = static_cast<int32_t>(seed);
-    return static_cast<float>(signedSeed) / 2147483648.0f;
+inline float ChannelAlpha2Processor::counterNoise(uint32_t counter, uint32_t key) {
+    // Two rounds of the lowbias32 integer hash: sample n of a channel depends only on (n, key)
+    auto mix = [](uint32_t x) {
+        x ^= x >> 16; x *= 0x7feb352du;
+        x ^= x >> 15; x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    };
+    const int32_t signedValue = static_cast<int32_t>(mix(mix(counter) ^ key));
+    return static_cast<float>(signedValue) / 2147483648.0f;
 }
 
-void ChannelAlpha2Processor::applySaturation(juce::AudioBuffer<float>& buffer, float amount) {
-    if (amount <= 0.001f) return;
-    float drive = 1.10f + amount * 0.15f;
-    // Process exactly 2 channels (we only support stereo)
-    for (int ch = 0; ch < 2; ++ch) {
-        auto* data = buffer.getWritePointer(ch);
-        int numSamples = buffer.getNumSamples();
-        for (int i = 0; i < numSamples; ++i) {
-            float x = data[i] * drive;
-            float tanhSat = fastTanh(x);
-            float softSat = softClip(x);
-            float hardSat = hardClip(x, 0.9f + amount * 0.1f);
-            float mixed = 0.5f * tanhSat + 0.3f * softSat + 0.2f * hardSat;
-            float wetMix = juce::jlimit(0.0f, 1.0f, amount);
-            data[i] = data[i] * (1.0f - wetMix) + mixed * wetMix;
-        }
+inline float ChannelAlpha2Processor::saturateSample(float input, float drive, float threshold, float wetMix, float dryMix) const {
+    const float x = input * drive;
+    const float mixed = 0.5f * fastTanh(x) + 0.3f * softClip(x) + 0.2f * hardClip(x, threshold);
+    return input * dryMix + mixed * wetMix;
+}
+
+ChannelAlpha2Processor::DDXStageSettings ChannelAlpha2Processor::makeDDXStageSettings(const DDXParameterBank& parameters) const {
+    const float emuAmount = parameters.getCurrentValue(ddxEmuAmount);
+    const float saturation = parameters.getCurrentValue(ddxSaturation) * emuAmount;
+    const float harmonics = parameters.getCurrentValue(ddxHarmonics);
+    const float noiseFloorDB = parameters.getCurrentValue(ddxNoiseFloor);
+    const float inputGainDB = parameters.getCurrentValue(ddxInputGain);
+    DDXStageSettings settings;
+    settings.saturation = saturation > 0.001f;
+    settings.drive = 1.10f + saturation * 0.15f;
+    settings.threshold = 0.9f + saturation * 0.1f;
+    settings.wetMix = juce::jlimit(0.0f, 1.0f, saturation);
+    settings.dryMix = 1.0f - settings.wetMix;
+    // x + g * (0.3 x^2 + 0.2 x^3 + 0.1 x^5), even and odd harmonics
+    settings.harmonics = harmonics > 0.001f;
+    settings.harmonic2 = harmonics * 0.5f * 0.3f;
+    settings.harmonic3 = harmonics * 0.5f * 0.2f;
+    settings.harmonic5 = harmonics * 0.5f * 0.1f;
+    if (noiseFloorDB > -119.0f || inputGainDB > -10.0f) {
+        float baseNoiseGain = juce::Decibels::decibelsToGain(noiseFloorDB);
+        float gainNoise = juce::Decibels::decibelsToGain(inputGainDB * 0.1f);
+        settings.noiseGain = baseNoiseGain * gainNoise * emuAmount * 0.01f;
+        settings.noise = settings.noiseGain >= 0.000001f && channelSeeds.size() >= 2 && noiseHPFStates.size() >= 2;
     }
+    return settings;
 }
 
-void ChannelAlpha2Processor::applyHarmonics(juce::AudioBuffer<float>& buffer, float amount) {
-    float harmonicsGain = amount * 0.5f;
-    // Process exactly 2 channels (we only support stereo)
-    for (int ch = 0; ch < 2; ++ch) {
-        auto* data = buffer.getWritePointer(ch);
-        int numSamples = buffer.getNumSamples();
-        for (int i = 0; i < numSamples; ++i) {
-            float x = data[i];
-            // Add harmonic distortion (even and odd harmonics)
-            float x2 = x * x * harmonicsGain * 0.3f;
-            float x3 = x * x * x * harmonicsGain * 0.2f;
-            float x5 = x * x * x * x * x * harmonicsGain * 0.1f;
-            data[i] += x2 + x3 + x5;
-        }
+// The stage kernels below run both channels in one pass, with no branches or loop-carried
+// state, so the compiler emits SSE2/AVX2/NEON for them from the same source.
+void ChannelAlpha2Processor::saturateRange(float* __restrict left, float* __restrict right, int numSamples, const DDXStageSettings& settings) const {
+    for (int i = 0; i < numSamples; ++i) {
+        left[i] = saturateSample(left[i], settings.drive, settings.threshold, settings.wetMix, settings.dryMix);
+        right[i] = saturateSample(right[i], settings.drive, settings.threshold, settings.wetMix, settings.dryMix);
     }
 }
 
-void ChannelAlpha2Processor::applyNoise(juce::AudioBuffer<float>& buffer, float noiseFloorDB, float inputGainDB, float emuAmount) {
-    if (noiseFloorDB <= -119.0f && inputGainDB <= -10.0f) return;
-    float baseNoiseGain = juce::Decibels::decibelsToGain(noiseFloorDB);
-    float gainNoise = juce::Decibels::decibelsToGain(inputGainDB * 0.1f);
-    float totalNoiseGain = baseNoiseGain * gainNoise * emuAmount * 0.01f;
-    if (totalNoiseGain < 0.000001f) return;
+void ChannelAlpha2Processor::harmonicsRange(float* __restrict left, float* __restrict right, int numSamples, const DDXStageSettings& settings) const {
+    const float c2 = settings.harmonic2, c3 = settings.harmonic3, c5 = settings.harmonic5;
+    for (int i = 0; i < numSamples; ++i) {
+        const float l = left[i], r = right[i];
+        const float l2 = l * l, r2 = r * r;
+        left[i] = l + l2 * (c2 + l * (c3 + c5 * l2));
+        right[i] = r + r2 * (c2 + r * (c3 + c5 * r2));
+    }
+}
 
-    // Process exactly 2 channels (we only support stereo)
-    for (int ch = 0; ch < 2 && ch < (int)channelSeeds.size() && ch < (int)noiseHPFStates.size(); ++ch) {
-        auto* data = buffer.getWritePointer(ch);
-        int numSamples = buffer.getNumSamples();
-        uint32_t& seed = channelSeeds[ch];
-        float& hpfState = noiseHPFStates[ch];
-        for (int i = 0; i < numSamples; ++i) {
-            float whiteNoise = generateWhiteNoise(seed);
-            hpfState = noiseHPFCoeff * hpfState + (1.0f - noiseHPFCoeff) * whiteNoise;
-            float filteredNoise = whiteNoise - hpfState;
-            data[i] += filteredNoise * totalNoiseGain;
+void ChannelAlpha2Processor::noiseRange(float* __restrict left, float* __restrict right, int numSamples, const DDXStageSettings& settings) {
+    float* __restrict leftNoise = noiseScratch.getWritePointer(0);
+    float* __restrict rightNoise = noiseScratch.getWritePointer(1);
+    const uint32_t leftKey = channelSeeds[0], rightKey = channelSeeds[1];
+    const float feedback = noiseHPFCoeff, feedIn = 1.0f - noiseHPFCoeff;
+    const float totalNoiseGain = settings.noiseGain;
+
+    for (int start = 0; start < numSamples; start += noiseScratch.getNumSamples()) {
+        const int length = juce::jmin(noiseScratch.getNumSamples(), numSamples - start);
+        if (length <= 0) break;
+        // White noise for the whole chunk: independent per sample, so this vectorises
+        for (int i = 0; i < length; ++i) {
+            const uint32_t counter = noiseCounter + static_cast<uint32_t>(i);
+            leftNoise[i] = counterNoise(counter, leftKey);
+            rightNoise[i] = counterNoise(counter, rightKey);
         }
+        noiseCounter += static_cast<uint32_t>(length);
+        // 300 Hz high-pass (white minus its one-pole low-pass), both channels interleaved
+        float leftState = noiseHPFStates[0], rightState = noiseHPFStates[1];
+        for (int i = 0; i < length; ++i) {
+            leftState = feedback * leftState + feedIn * leftNoise[i];
+            rightState = feedback * rightState + feedIn * rightNoise[i];
+            left[start + i] += (leftNoise[i] - leftState) * totalNoiseGain;
+            right[start + i] += (rightNoise[i] - rightState) * totalNoiseGain;
+        }
+        noiseHPFStates[0] = leftState;
+        noiseHPFStates[1] = rightState;
     }
 }
 
-void ChannelAlpha2Processor::applyIntersampleModulation(juce::AudioBuffer<float>& buffer, float amount) {
-    if (!oversamplerPrepared) {
-        oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-            2, 2, // 2x oversampling
-            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-            false);
-        oversampler->initProcessing(spec.maximumBlockSize);
-        oversamplerPrepared = true;
-    }
+void ChannelAlpha2Processor::prepareOversampler() {
+    // Factor choice 0/1/2 = 2x/4x/8x = 1/2/3 half-band stages
+    const int numStages = static_cast<int>(apvts.getRawParameterValue(PARAM_INTERSAMPLE_FACTOR)->load()) + 1;
+    const bool linearPhase = apvts.getRawParameterValue(PARAM_INTERSAMPLE_QUALITY)->load() > 0.5f;
+    oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
+        2, static_cast<size_t>(numStages),
+        linearPhase ? juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple
+                    : juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+        true, true); // Integer latency, so the host and the dry path can match it exactly
+    oversampler->initProcessing(spec.maximumBlockSize);
+    oversamplerLatency = juce::roundToInt(oversampler->getLatencyInSamples());
+    // Only the stereo strip goes through the oversampler; other layouts add no latency
+    if (busLayout.size() != 2)
+        oversamplerLatency = 0;
+    latencyCompensation.setMaximumDelayInSamples(juce::jmax(1, oversamplerLatency));
+    latencyCompensation.prepare(spec);
+    latencyCompensation.setDelay(static_cast<float>(oversamplerLatency));
+    setLatencySamples(oversamplerLatency);
+}
 
-    float threshold = 1.0f - (amount * 0.3f);
-    float hardness = 0.5f + amount * 0.5f;
+void ChannelAlpha2Processor::applyLatencyCompensation(juce::AudioBuffer<float>& buffer) {
+    if (oversamplerLatency == 0 || buffer.getNumChannels() < 2) return;
+    juce::dsp::AudioBlock<float> block(buffer);
+    block = block.getSubsetChannelBlock(0, 2);
+    juce::dsp::ProcessContextReplacing<float> ctx(block);
+    latencyCompensation.process(ctx);
+}
 
+void ChannelAlpha2Processor::applyIntersampleModulation(juce::AudioBuffer<float>& buffer, const DDXParameterBank& blockStart) {
     juce::dsp::AudioBlock<float> block(buffer);
     if (block.getNumChannels() > 2) {
         block = block.getSubsetChannelBlock(0, 2);
@@ -436,6 +773,36 @@ void ChannelAlpha2Processor::applyIntersampleModulation(juce::AudioBuffer<float>
     // Upsample
     juce::dsp::AudioBlock<float> oversampledBlock = oversampler->processSamplesUp(block);
 
+    // Knob down: the round trip alone keeps latency and filter state consistent
+    DDXParameterBank parameters = blockStart;
+    const bool ramping = parameters.isSmoothing(ddxIntersample);
+    float amount = parameters.getCurrentValue(ddxIntersample);
+    if (!ramping && amount <= 0.001f) {
+        oversampler->processSamplesDown(block);
+        return;
+    }
+
+    // Same sub-blocks as the rest of the chain, scaled up to the oversampled rate
+    const int factor = static_cast<int>(oversampler->getOversamplingFactor());
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    for (int start = 0; start < numSamples; start += preEmphasisSubBlock) {
+        const int length = juce::jmin(preEmphasisSubBlock, numSamples - start);
+        if (ramping) {
+            parameters.advance(length);
+            amount = parameters.getCurrentValue(ddxIntersample);
+        }
+        if (amount <= 0.001f) continue;
+        applyIntersampleClip(oversampledBlock.getSubBlock((size_t)(start * factor), (size_t)(length * factor)), amount);
+    }
+
+    // Downsample
+    oversampler->processSamplesDown(block);
+}
+
+void ChannelAlpha2Processor::applyIntersampleClip(juce::dsp::AudioBlock<float> oversampledBlock, float amount) {
+    float threshold = 1.0f - (amount * 0.3f);
+    float hardness = 0.5f + amount * 0.5f;
+
     // Process at oversampled rate (only 2 channels)
     for (int ch = 0; ch < (int)oversampledBlock.getNumChannels(); ++ch) {
         auto* data = oversampledBlock.getChannelPointer(ch);
@@ -458,9 +825,6 @@ void ChannelAlpha2Processor::applyIntersampleModulation(juce::AudioBuffer<float>
             data[i] += data[i] * data[i] * data[i] * 0.02f * amount;
         }
     }
-
-    // Downsample
-    oversampler->processSamplesDown(block);
 }
 
 void ChannelAlpha2Processor::setMuted(bool shouldMute) { muted = shouldMute; }
@@ -470,13 +834,45 @@ void ChannelAlpha2Processor::setAutoRec(bool shouldAutoRec) { autoRec = shouldAu
 void ChannelAlpha2Processor::setDDXEmulation(bool shouldEnable) {
     ddxEmulation = shouldEnable;
     if (!shouldEnable) {
-        emuAmountSmoother.setTargetValue(0.0f);
+        ddxParameters.setTargetValue(ddxEmuAmount, 0.0f);
     }
 }
 void ChannelAlpha2Processor::setBusSendEnabled(bool shouldEnable) { busSendEnabled = shouldEnable; }
 
 int ChannelAlpha2Processor::getChannelID() const {
-    return static_cast<int>(apvts.getRawParameterValue(PARAM_CHANNEL_ID)->load());
+    const int named = namedChannelID.load();
+    return named > 0 ? named : static_cast<int>(apvts.getRawParameterValue(PARAM_CHANNEL_ID)->load());
+}
+
+void ChannelAlpha2Processor::setChannelName(const juce::String& name) {
+    const juce::String trimmed = name.trim();
+    apvts.state.setProperty("channelName", trimmed, nullptr);
+    // Our lane keeps the name alive from here on
+    namedChannelID = trimmed.isEmpty() ? 0 : BusShared::getInstance().acquireNamedChannel(trimmed.toRawUTF8());
+    switchBusChannel();
+}
+
+void ChannelAlpha2Processor::timerCallback() {
+    if (busChannelPending.exchange(false))
+        switchBusChannel();
+}
+
+void ChannelAlpha2Processor::switchBusChannel() {
+    // A channel name, if set, overrides the number
+    const int newChannelID = getChannelID();
+    const juce::ScopedLock busLock(busWriterLock);
+    if (newChannelID != currentChannelID) {
+        // Claim and size the new lane before the audio thread sees it, so the ring is allocated
+        // here and the strip never sends into a lane that isn't ready
+        auto& bus = BusShared::getInstance();
+        const BusWriterHandle newWriter = bus.registerWriter(newChannelID);
+        if (busSampleRate > 0.0)
+            bus.prepareWriter(newWriter, busSampleRate, busBlockSize, busLayout);
+        // processBlock may still be writing through the old handle; unregisterWriter() waits
+        // for it before the ring is freed
+        bus.unregisterWriter(busWriter.exchange(newWriter));
+        currentChannelID = newChannelID;
+    }
 }
 
 juce::AudioProcessorEditor* ChannelAlpha2Processor::createEditor() {
@@ -512,6 +908,7 @@ void ChannelAlpha2Processor::setStateInformation(const void* data, int sizeInByt
             pluginHeight = state.getProperty("pluginHeight", 530);
             bool ddxState = state.getProperty("ddxEmulation", false);
             setDDXEmulation(ddxState);
+            setChannelName(state.getProperty("channelName").toString());
         }
     }
 }
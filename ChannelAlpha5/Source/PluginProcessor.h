@@ -5,9 +5,13 @@
 #include <JuceHeader.h>
 #include <random>
 #include <cstdint>
+#include <array>
+#include "BusShared.h"
+#include "SmoothedParameterBank.h"
 
 class ChannelAlpha2Processor : public juce::AudioProcessor,
-    public juce::AudioProcessorValueTreeState::Listener {
+    public juce::AudioProcessorValueTreeState::Listener,
+    private juce::Timer {
 public:
     ChannelAlpha2Processor();
     ~ChannelAlpha2Processor() override;
@@ -56,6 +60,18 @@ public:
     void setBusSendEnabled(bool shouldEnable);
 
     int getChannelID() const;
+    BusWriterHandle getBusWriter() const { return busWriter.load(); }
+    // Named bus channel ("drums/kick") sent to instead of the numbered one while not empty.
+    // Saved with the state. Message thread only.
+    void setChannelName(const juce::String& name);
+    juce::String getChannelName() const { return apvts.state.getProperty("channelName").toString(); }
+    bool isChannelNameResolved() const { return namedChannelID.load() > 0; }
+
+    // Runs DDX3216 through the original multi-pass path instead of the fused one.
+    // For checking the two against each other; call before prepareToPlay.
+    void setUseReferenceDDXPath(bool shouldUseReference) { useReferenceDDXPath = shouldUseReference; }
+    // Fixed seed for the DDX noise (0 = fresh random noise every prepareToPlay). Call before prepareToPlay.
+    void setNoiseSeed(uint32_t seed) { noiseSeed = seed; }
 
     int pluginWidth = 160;
     int pluginHeight = 530;
@@ -75,66 +91,143 @@ private:
 
     // Track current channel ID for registration changes
     int currentChannelID = 1;
+    // Channel ID our name was given (0 = use the numbered channel)
+    std::atomic<int> namedChannelID{ 0 };
+    // Moves our lane to getChannelID() if that changed. Message thread only.
+    void switchBusChannel();
+    // Channel ID parameter moved since the timer last looked
+    std::atomic<bool> busChannelPending{ false };
+    void timerCallback() override;
+    // Lane this instance owns on the bus (read by the audio thread)
+    std::atomic<BusWriterHandle> busWriter{ BusWriterHandle{} };
+    // Host format the bus ring is sized for (0 until prepareToPlay). Guarded by busWriterLock,
+    // so prepareToPlay and a channel switch never size or free the same lane at once.
+    juce::CriticalSection busWriterLock;
+    double busSampleRate = 0.0;
+    int busBlockSize = 0;
+    juce::AudioChannelSet busLayout = juce::AudioChannelSet::stereo();
 
     // Smooth parameter changes
     juce::LinearSmoothedValue<float> muteGain;
     juce::LinearSmoothedValue<float> faderGain;
     juce::LinearSmoothedValue<float> panValue;
 
-    // DDX3216 parameter smoothers
-    juce::LinearSmoothedValue<float> emuAmountSmoother;
-    juce::LinearSmoothedValue<float> preEmphasisSmoother;
-    juce::LinearSmoothedValue<float> harmonicsSmoother;
-    juce::LinearSmoothedValue<float> intersampleSmoother;
-    juce::LinearSmoothedValue<float> saturationSmoother;
-    juce::LinearSmoothedValue<float> noiseFloorSmoother;
-    juce::LinearSmoothedValue<float> inputGainSmoother;
-
-    // DDX3216 DSP chains
+    // Pan laws, tabulated once: left gain against pan position 0 (hard left) to 1 (hard right).
+    // The right gain is the same curve read from the other end.
+    enum PanLaw { panLawMinus3dB = 0, panLawMinus4p5dB, panLawMinus6dB, panLaw0dB, numPanLaws };
+    static constexpr int panTableSize = 256;
+    std::array<std::array<float, panTableSize + 1>, numPanLaws> panLawTables;
+    juce::AudioBuffer<float> panGainScratch; // Per-sample left/right gains while ramping
+    void buildPanLawTables();
+    void applyPanAndGain(juce::AudioBuffer<float>& buffer);
+    void applyGainOnly(juce::AudioBuffer<float>& buffer);
+    inline float lookupPanGain(const std::array<float, panTableSize + 1>& table, float position) const;
+
+    // DDX3216 parameters, smoothed together and stepped every preEmphasisSubBlock samples
+    // (not once per host block), so automation follows at the same rate at any buffer size
+    enum DDXParameter {
+        ddxEmuAmount = 0, ddxPreEmphasis, ddxHarmonics, ddxIntersample,
+        ddxSaturation, ddxNoiseFloor, ddxInputGain, numDDXParameters
+    };
+    using DDXParameterBank = SmoothedParameterBank<numDDXParameters>;
+    DDXParameterBank ddxParameters;
+
+    // DDX3216 DSP chains (IIR::Filter is mono, so each stage is duplicated per channel
+    // with shared coefficients)
+    using StereoBiquad = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>;
     juce::dsp::ProcessorChain<
-        juce::dsp::IIR::Filter<float>,      // 0: HPF (22Hz)
-        juce::dsp::IIR::Filter<float>,      // 1: Low-shelf warmth
-        juce::dsp::IIR::Filter<float>,      // 2: High-shelf air
-        juce::dsp::IIR::Filter<float>       // 3: Pre-emphasis
+        StereoBiquad,      // 0: HPF (22Hz)
+        StereoBiquad,      // 1: Low-shelf warmth
+        StereoBiquad,      // 2: High-shelf air
+        StereoBiquad       // 3: Pre-emphasis
     > preEQChain;
 
     juce::dsp::ProcessorChain<
-        juce::dsp::IIR::Filter<float>       // Gentle tilt
+        StereoBiquad       // Gentle tilt
     > postEQChain;
 
     juce::dsp::ProcessSpec spec;
 
-    // Oversampling for intersample modulation
+    // Pre-emphasis peak (6 kHz, Q 1) coefficients are rewritten in place as the knob moves,
+    // stepped every preEmphasisSubBlock samples while it glides. Only the gain varies, so the
+    // frequency terms are worked out once in prepareToPlay.
+    static constexpr int preEmphasisSubBlock = 16;
+    float preEmphasisMinusTwoCos = 0.0f;
+    float preEmphasisAlpha = 0.0f;
+    float appliedPreEmphasisDB = -1.0f; // Gain the coefficients currently hold (-1 = none yet)
+    void updatePreEmphasisCoefficients(float gainDB) noexcept;
+
+    // Oversampling for intersample modulation, built in prepareToPlay (or when its
+    // factor/quality change) so the audio thread never allocates it
     std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
-    bool oversamplerPrepared = false;
+    // Delays the dry path by the oversampler's latency when DDX is off, so the latency we report always holds
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> latencyCompensation;
+    int oversamplerLatency = 0;
+    void prepareOversampler();
 
-    // Random generators for noise (one per channel)
+    // Noise: counter-based (stateless hash of sample counter and a per-channel key), so a
+    // whole block can be generated without a serial dependency between samples
     std::vector<uint32_t> channelSeeds;
     std::vector<float> noiseHPFStates;
     float noiseHPFCoeff{ 0.0f };
+    uint32_t noiseCounter = 0;
+    uint32_t noiseSeed = 0;
+    juce::AudioBuffer<float> noiseScratch;
 
     // DDX3216 processing functions
     void processDDX3216(juce::AudioBuffer<float>& buffer);
+    // The original stage-by-stage version, kept to check the fused path against
+    void processDDX3216Reference(juce::AudioBuffer<float>& buffer);
+    bool useReferenceDDXPath = false;
+
+    // Stage settings for one sub-block (or a whole block when nothing ramps), shared by both paths
+    struct DDXStageSettings {
+        bool saturation = false, harmonics = false, noise = false; // Stages that run
+        float drive = 0.0f, threshold = 0.0f, wetMix = 0.0f, dryMix = 0.0f;
+        float harmonic2 = 0.0f, harmonic3 = 0.0f, harmonic5 = 0.0f;
+        float noiseGain = 0.0f;
+    };
+    DDXStageSettings makeDDXStageSettings(const DDXParameterBank& parameters) const;
+
+    // Fused path: everything up to the oversampler runs tile by tile, so a tile goes through
+    // the whole chain while it sits in L1. Stages that are off for the block are compiled out
+    // of the instantiation rather than tested per tile; while parameters ramp, the all-stages
+    // one runs and checks each tile's settings. Its biquads compute exactly what
+    // IIR::Filter does (TDF-II, denormal snap at the same points) with their own state.
+    static constexpr int ddxTileSize = preEmphasisSubBlock;
+    static constexpr int numDDXBiquads = 5; // Pre-EQ 0-3, post tilt
+    struct BiquadState { float s1 = 0.0f, s2 = 0.0f; };
+    BiquadState ddxBiquadStates[numDDXBiquads][2];
+    template <bool withSaturation, bool withHarmonics, bool withNoise>
+    void processDDXTiles(float* left, float* right, int numSamples, DDXStageSettings settings);
+    static inline void processStereoBiquad(const float* coefficients, BiquadState* states, float* left, float* right, int numSamples) noexcept;
+    void snapDDXBiquadStates(int first, int last) noexcept;
 
     // Individual processing functions
-    void applySaturation(juce::AudioBuffer<float>& buffer, float amount);
-    void applyHarmonics(juce::AudioBuffer<float>& buffer, float amount);
-    void applyNoise(juce::AudioBuffer<float>& buffer, float noiseFloorDB, float inputGainDB, float emuAmount);
-    void applyIntersampleModulation(juce::AudioBuffer<float>& buffer, float amount);
+    void saturateRange(float* left, float* right, int numSamples, const DDXStageSettings& settings) const;
+    void harmonicsRange(float* left, float* right, int numSamples, const DDXStageSettings& settings) const;
+    void noiseRange(float* left, float* right, int numSamples, const DDXStageSettings& settings);
+    void applyIntersampleModulation(juce::AudioBuffer<float>& buffer, const DDXParameterBank& blockStart);
+    void applyIntersampleClip(juce::dsp::AudioBlock<float> oversampledBlock, float amount);
+    void applyLatencyCompensation(juce::AudioBuffer<float>& buffer);
 
     // Helper functions
     inline float fastTanh(float x) const;
     inline float softClip(float x) const;
     inline float hardClip(float x, float threshold) const;
-    inline float generateWhiteNoise(uint32_t& seed) const;
+    static inline float counterNoise(uint32_t counter, uint32_t key);
+    inline float saturateSample(float input, float drive, float threshold, float wetMix, float dryMix) const;
 
     static constexpr const char* PARAM_CHANNEL_ID = "channelID";
     static constexpr const char* PARAM_FADER = "fader";
     static constexpr const char* PARAM_PAN = "pan";
+    static constexpr const char* PARAM_PAN_LAW = "panLaw";
     static constexpr const char* PARAM_EMU_AMOUNT = "emuAmount";
     static constexpr const char* PARAM_PRE_EMPHASIS = "preEmphasis";
     static constexpr const char* PARAM_HARMONICS = "harmonics";
     static constexpr const char* PARAM_INTERSAMPLE = "intersampleMod";
+    static constexpr const char* PARAM_INTERSAMPLE_FACTOR = "intersampleFactor";
+    static constexpr const char* PARAM_INTERSAMPLE_QUALITY = "intersampleQuality";
     static constexpr const char* PARAM_NOISE_FLOOR = "noiseFloor";
     static constexpr const char* PARAM_INPUT_GAIN = "inputGain";
     static constexpr const char* PARAM_SELECT = "select";
@@ -143,6 +236,7 @@ private:
     static constexpr const char* PARAM_MUTE = "mute";
     static constexpr const char* PARAM_DDX_EMULATION = "ddxEmulation";
     static constexpr const char* PARAM_BUS_SEND_ENABLED = "busSendEnabled";
+    static constexpr const char* PARAM_BUS_SEND_LEVEL = "busSendLevel";
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -0,0 +1,88 @@
+#pragma once
+#include <JuceHeader.h>
+
+// A set of linearly smoothed parameters that advance together, a sub-block at a time.
+// Ramps behave like juce::LinearSmoothedValue (same step count and step size), but the
+// values live in parallel arrays and advance() moves every ramp in one branch-free loop,
+// so stepping all of them costs about as much as stepping one. Stages read the values
+// after each advance, which makes automation accurate to the sub-block instead of the
+// host block. Trivially copyable, so a pass can replay a ramp from a saved copy.
+template <int numParameters>
+class SmoothedParameterBank
+{
+public:
+    // Padded so advance() covers whole vectors
+    static constexpr int numSlots = (numParameters + 7) & ~7;
+
+    // Ramp length for every parameter; jumps each of them to its target
+    void reset(double sampleRate, double rampLengthSeconds) noexcept
+    {
+        stepsToTarget = (int)std::floor(rampLengthSeconds * sampleRate);
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            current[i] = target[i];
+            step[i] = 0.0f;
+            countdown[i] = 0.0f;
+        }
+    }
+
+    void setCurrentAndTargetValue(int index, float value) noexcept
+    {
+        current[index] = target[index] = value;
+        step[index] = 0.0f;
+        countdown[index] = 0.0f;
+    }
+
+    void setTargetValue(int index, float value) noexcept
+    {
+        if (value == target[index])
+            return;
+
+        if (stepsToTarget <= 0)
+        {
+            setCurrentAndTargetValue(index, value);
+            return;
+        }
+
+        target[index] = value;
+        countdown[index] = (float)stepsToTarget;
+        step[index] = (value - current[index]) / (float)stepsToTarget;
+    }
+
+    // Moves every ramp on by numSamples; ramps that reach their target land exactly on it
+    void advance(int numSamples) noexcept
+    {
+        const float samples = (float)numSamples;
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            // Measured back from the target, so a ramp that runs out lands on it exactly
+            const float remaining = countdown[i] - samples;
+            countdown[i] = remaining > 0.0f ? remaining : 0.0f;
+            current[i] = target[i] - step[i] * countdown[i];
+        }
+    }
+
+    float getCurrentValue(int index) const noexcept { return current[index]; }
+    float getTargetValue(int index) const noexcept { return target[index]; }
+    bool isSmoothing(int index) const noexcept { return countdown[index] > 0.0f; }
+
+    bool isSmoothing() const noexcept
+    {
+        float remaining = 0.0f;
+
+        for (int i = 0; i < numSlots; ++i)
+            remaining += countdown[i];
+
+        return remaining > 0.0f;
+    }
+
+private:
+    // Step counts are kept as floats so the whole update vectorises; they're exact up to 2^24
+    alignas(32) float current[numSlots] = {};
+    alignas(32) float target[numSlots] = {};
+    alignas(32) float step[numSlots] = {};
+    alignas(32) float countdown[numSlots] = {};
+    int stepsToTarget = 0;
+};
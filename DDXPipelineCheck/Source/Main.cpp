@@ -0,0 +1,152 @@
+// ============================================================================
+// DDXPipelineCheck - fused DDX3216 path against the original stage-by-stage one
+// ============================================================================
+// Runs two Channel Alpha 5 processors side by side on the same input, one on the
+// fused tile pipeline and one on processDDX3216Reference, and requires their
+// outputs to match bit for bit. Each scenario switches a different set of stages
+// on, uses ragged host block sizes and moves knobs mid-run so the per-sub-block
+// parameter ramps (and the pre-emphasis coefficient glide) are covered too.
+//
+// Usage: DDXPipelineCheck [blocks=400] [maxBlockSize=512]
+// Exits non-zero on the first mismatch.
+#include <JuceHeader.h>
+#include "../../ChannelAlpha5/Source/PluginProcessor.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+struct Scenario
+{
+    const char* name;
+    float emuAmount;    // 0..2
+    float harmonics;    // 0..1
+    float noiseFloor;   // dB
+    float inputGain;    // dB
+    float intersample;  // 0..1
+};
+
+static void setParameter(ChannelAlpha2Processor& processor, const char* id, float value)
+{
+    auto* parameter = processor.getAPVTS().getParameter(id);
+    jassert(parameter != nullptr);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+static void applyScenario(ChannelAlpha2Processor& processor, const Scenario& scenario)
+{
+    setParameter(processor, "ddxEmulation", 1.0f);
+    setParameter(processor, "busSendEnabled", 0.0f);
+    setParameter(processor, "emuAmount", scenario.emuAmount);
+    setParameter(processor, "harmonics", scenario.harmonics);
+    setParameter(processor, "noiseFloor", scenario.noiseFloor);
+    setParameter(processor, "inputGain", scenario.inputGain);
+    setParameter(processor, "intersampleMod", scenario.intersample);
+    setParameter(processor, "preEmphasis", 0.3f);
+}
+
+// Returns false (and says where) if the two processors ever disagree
+static bool runScenario(const Scenario& scenario, int numBlocks, int maxBlockSize)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr uint32_t noiseSeed = 0x5eed1234;
+
+    ChannelAlpha2Processor fused, reference;
+    reference.setUseReferenceDDXPath(true);
+
+    for (auto* processor : { &fused, &reference })
+    {
+        processor->setNoiseSeed(noiseSeed);
+        applyScenario(*processor, scenario);
+        processor->prepareToPlay(sampleRate, maxBlockSize);
+    }
+
+    juce::AudioBuffer<float> fusedBuffer(2, maxBlockSize), referenceBuffer(2, maxBlockSize);
+    juce::MidiBuffer midi;
+    juce::Random random(42);
+    int64_t samplePosition = 0;
+
+    for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+    {
+        // Ragged host blocks, including ones shorter than a tile and ones that aren't a multiple of it
+        const int numSamples = blockIndex % 7 == 0 ? 1 + random.nextInt(15) : 1 + random.nextInt(maxBlockSize);
+
+        // Knobs move a few times over the run, so some blocks ramp and some don't
+        if (blockIndex % 50 == 25)
+        {
+            const float preEmphasis = random.nextFloat();
+            const float harmonics = scenario.harmonics > 0.0f ? random.nextFloat() : 0.0f;
+            const float intersample = scenario.intersample > 0.0f ? random.nextFloat() : 0.0f;
+
+            for (auto* processor : { &fused, &reference })
+            {
+                setParameter(*processor, "preEmphasis", preEmphasis);
+                setParameter(*processor, "harmonics", harmonics);
+                setParameter(*processor, "intersampleMod", intersample);
+            }
+        }
+
+        fusedBuffer.setSize(2, numSamples, false, false, true);
+        referenceBuffer.setSize(2, numSamples, false, false, true);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto* data = fusedBuffer.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = (random.nextFloat() * 2.0f - 1.0f) * 0.9f;
+
+            referenceBuffer.copyFrom(ch, 0, fusedBuffer, ch, 0, numSamples);
+        }
+
+        fused.processBlock(fusedBuffer, midi);
+        reference.processBlock(referenceBuffer, midi);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float* a = fusedBuffer.getReadPointer(ch);
+            const float* b = referenceBuffer.getReadPointer(ch);
+
+            if (std::memcmp(a, b, sizeof(float) * (size_t)numSamples) == 0)
+                continue;
+
+            for (int i = 0; i < numSamples; ++i)
+                if (std::memcmp(a + i, b + i, sizeof(float)) != 0)
+                {
+                    std::printf("  %-22s MISMATCH at sample %lld, channel %d: fused %.9g, reference %.9g\n",
+                        scenario.name, (long long)(samplePosition + i), ch, a[i], b[i]);
+                    return false;
+                }
+        }
+
+        samplePosition += numSamples;
+    }
+
+    std::printf("  %-22s bit-exact over %lld samples\n", scenario.name, (long long)samplePosition);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; // The parameter state needs a message manager
+
+    const int numBlocks = argc > 1 ? juce::jmax(1, std::atoi(argv[1])) : 400;
+    const int maxBlockSize = argc > 2 ? juce::jlimit(16, 8192, std::atoi(argv[2])) : 512;
+
+    // Saturation follows the emulation amount, so it is on whenever DDX is; the rest vary
+    const Scenario scenarios[] = {
+        { "saturation",            0.5f, 0.0f, -120.0f, -12.0f, 0.0f },
+        { "saturation+harmonics",  1.0f, 0.8f, -120.0f, -12.0f, 0.0f },
+        { "saturation+noise",      1.0f, 0.0f,  -60.0f,  20.0f, 0.0f },
+        { "all stages",            0.8f, 0.5f,  -60.0f,  20.0f, 0.0f },
+        { "all + intersample",     0.8f, 0.5f,  -60.0f,  20.0f, 0.7f },
+    };
+
+    std::printf("DDX3216 fused vs reference: %d blocks of up to %d samples per scenario\n", numBlocks, maxBlockSize);
+
+    bool allExact = true;
+
+    for (const auto& scenario : scenarios)
+        allExact = runScenario(scenario, numBlocks, maxBlockSize) && allExact;
+
+    std::printf(allExact ? "PASS\n" : "FAIL\n");
+    return allExact ? 0 : 1;
+}
@@ -0,0 +1,377 @@
+// ============================================================================
+// ProcessorBenchmark - processBlock cost of Channel Alpha 5 and Bus Alpha 5
+// ============================================================================
+// Drives both processors headless (no editor, no device) and times every call to
+// processBlock. Channel Alpha 5 is measured with DDX off and with each combination
+// of its optional DDX3216 stages on top of the always-on EQ and saturation; Bus
+// Alpha 5 is measured reading from a number of channel strips sending to it.
+//
+// Per configuration it reports the mean cost per sample, the p50/p99/max time of one
+// block, and the mean and p99 share of the real-time budget (block length / rate).
+//
+// Usage: ProcessorBenchmark [options]
+//   --rate <Hz>          sample rate                            (48000)
+//   --block <samples>    host block size                        (512)
+//   --channels <n>       channels in the host buffer; both
+//                        processors keep a stereo layout and
+//                        render the first two                   (2)
+//   --seconds <s>        audio rendered per configuration       (10)
+//   --oversampling <n>   intersample factor: 2, 4 or 8          (2)
+//   --sources <n>        channel strips feeding the bus         (4)
+//   --csv                machine-readable output
+//   --max-p99 <percent>  exit 1 if any p99 exceeds this share of the budget
+//
+// The bus is also run with host blocks as long as its default 20 ms target latency, and any
+// lane underrun while the sources are feeding it in step fails the run (exit 1).
+#include <JuceHeader.h>
+#include "../../BusAlpha5/Source/BusShared.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// The plugins' createPluginFilter(), renamed per source file by CMakeLists.txt. Going through
+// them (and the generic parameter interface) keeps the two projects' headers, each with its
+// own copy of BusShared.h, out of this file.
+juce::AudioProcessor* JUCE_CALLTYPE createChannelAlpha5PluginFilter();
+juce::AudioProcessor* JUCE_CALLTYPE createBusAlpha5PluginFilter();
+
+struct Settings
+{
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    int numChannels = 2;
+    double seconds = 10.0;
+    int oversampling = 2;
+    int numSources = 4;
+    bool csv = false;
+    double maxP99Percent = 0.0; // 0 = don't fail
+};
+
+struct Result
+{
+    double nsPerSample = 0.0;
+    double p50 = 0.0, p99 = 0.0, max = 0.0; // Nanoseconds per block
+    double meanPercent = 0.0, p99Percent = 0.0;
+    int underruns = 0; // Bus only: lanes that ran dry while timed
+};
+
+// Which optional DDX stages a run switches on
+struct DDXStages
+{
+    bool enabled, harmonics, noise, intersample;
+};
+
+static constexpr int channelBusID = 32; // Out of the way of the 1-based channels a session would use
+
+static void setParameter(juce::AudioProcessor& processor, const char* id, float value)
+{
+    for (auto* parameter : processor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            if (ranged->getParameterID() == id)
+            {
+                ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+                return;
+            }
+
+    jassertfalse; // No such parameter
+}
+
+static void configureChannel(juce::AudioProcessor& processor, const Settings& settings, const DDXStages& stages, bool sendToBus)
+{
+    setParameter(processor, "channelID", (float)channelBusID);
+    setParameter(processor, "busSendEnabled", sendToBus ? 1.0f : 0.0f);
+    setParameter(processor, "ddxEmulation", stages.enabled ? 1.0f : 0.0f);
+    setParameter(processor, "emuAmount", 1.0f);
+    setParameter(processor, "preEmphasis", 0.5f);
+    setParameter(processor, "harmonics", stages.harmonics ? 0.5f : 0.0f);
+    setParameter(processor, "noiseFloor", stages.noise ? -60.0f : -120.0f);
+    setParameter(processor, "inputGain", stages.noise ? 20.0f : -12.0f);
+    setParameter(processor, "intersampleMod", stages.intersample ? 0.5f : 0.0f);
+    setParameter(processor, "intersampleFactor", settings.oversampling == 8 ? 2.0f : settings.oversampling == 4 ? 1.0f : 0.0f);
+
+    processor.setPlayConfigDetails(2, 2, settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+}
+
+// Looping band-limited-ish noise at about -12 dBFS, so the saturation and clipper do real work
+static juce::AudioBuffer<float> makeSource(const Settings& settings)
+{
+    juce::AudioBuffer<float> source(settings.numChannels, juce::jmax((int)settings.sampleRate, 4 * settings.blockSize));
+    juce::Random random(1234);
+
+    for (int ch = 0; ch < source.getNumChannels(); ++ch)
+    {
+        float lowPassed = 0.0f;
+        for (int i = 0; i < source.getNumSamples(); ++i)
+        {
+            lowPassed += 0.3f * ((random.nextFloat() * 2.0f - 1.0f) - lowPassed);
+            source.setSample(ch, i, lowPassed * 0.5f);
+        }
+    }
+
+    return source;
+}
+
+static void fillBlock(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>& source, int64_t position)
+{
+    const int offset = (int)(position % (source.getNumSamples() - buffer.getNumSamples()));
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        buffer.copyFrom(ch, 0, source, ch, offset, buffer.getNumSamples());
+}
+
+static Result summarise(std::vector<double>& blockNanos, const Settings& settings)
+{
+    Result result;
+    if (blockNanos.empty())
+        return result;
+
+    double total = 0.0;
+    for (auto nanos : blockNanos)
+        total += nanos;
+
+    std::sort(blockNanos.begin(), blockNanos.end());
+
+    const double budgetNanos = settings.blockSize / settings.sampleRate * 1.0e9;
+    const double mean = total / (double)blockNanos.size();
+
+    result.nsPerSample = mean / settings.blockSize;
+    result.p50 = blockNanos[blockNanos.size() / 2];
+    result.p99 = blockNanos[juce::jmin(blockNanos.size() - 1, blockNanos.size() * 99 / 100)];
+    result.max = blockNanos.back();
+    result.meanPercent = 100.0 * mean / budgetNanos;
+    result.p99Percent = 100.0 * result.p99 / budgetNanos;
+    return result;
+}
+
+static int getNumBlocks(const Settings& settings)
+{
+    return juce::jmax(1, (int)(settings.seconds * settings.sampleRate / settings.blockSize));
+}
+
+// Blocks rendered before timing starts: settles the smoothers, caches and branch predictors
+static constexpr int warmUpBlocks = 64;
+
+static Result runChannel(const Settings& settings, const DDXStages& stages, const juce::AudioBuffer<float>& source)
+{
+    std::unique_ptr<juce::AudioProcessor> channel(createChannelAlpha5PluginFilter());
+    auto& processor = *channel;
+    configureChannel(processor, settings, stages, false);
+
+    juce::AudioBuffer<float> buffer(settings.numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+    std::vector<double> blockNanos;
+    const int numBlocks = getNumBlocks(settings);
+    blockNanos.reserve((size_t)numBlocks);
+
+    for (int block = -warmUpBlocks; block < numBlocks; ++block)
+    {
+        fillBlock(buffer, source, (int64_t)(block + warmUpBlocks) * settings.blockSize);
+
+        const auto start = std::chrono::steady_clock::now();
+        processor.processBlock(buffer, midi);
+        const auto end = std::chrono::steady_clock::now();
+
+        if (block >= 0)
+            blockNanos.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    processor.releaseResources();
+    return summarise(blockNanos, settings);
+}
+
+// The bus reads what the strips sent this block; only its own processBlock is timed
+static Result runBus(const Settings& settings, const juce::AudioBuffer<float>& source)
+{
+    std::vector<std::unique_ptr<juce::AudioProcessor>> strips;
+    for (int i = 0; i < settings.numSources; ++i)
+    {
+        strips.emplace_back(createChannelAlpha5PluginFilter());
+        configureChannel(*strips.back(), settings, { false, false, false, false }, true);
+    }
+
+    std::unique_ptr<juce::AudioProcessor> busProcessor(createBusAlpha5PluginFilter());
+    auto& bus = *busProcessor;
+    setParameter(bus, "channelID", (float)channelBusID);
+    bus.setPlayConfigDetails(0, 2, settings.sampleRate, settings.blockSize);
+    bus.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    juce::AudioBuffer<float> stripBuffer(2, settings.blockSize);
+    juce::AudioBuffer<float> busBuffer(settings.numChannels, settings.blockSize);
+    juce::MidiBuffer midi;
+    std::vector<double> blockNanos;
+    const int numBlocks = getNumBlocks(settings);
+    blockNanos.reserve((size_t)numBlocks);
+
+    // Longer warm-up: the bus holds back its target latency before the lanes start playing
+    const int busWarmUpBlocks = warmUpBlocks + (int)std::ceil(0.25 * settings.sampleRate / settings.blockSize);
+
+    BusChannelHealth health;
+    uint32_t underrunsAtStart = 0;
+
+    for (int block = -busWarmUpBlocks; block < numBlocks; ++block)
+    {
+        if (block == 0 && BusShared::getInstance().getChannelHealth(channelBusID, health))
+            underrunsAtStart = health.underruns;
+
+        for (auto& strip : strips)
+        {
+            fillBlock(stripBuffer, source, (int64_t)(block + busWarmUpBlocks) * settings.blockSize);
+            strip->processBlock(stripBuffer, midi);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        bus.processBlock(busBuffer, midi);
+        const auto end = std::chrono::steady_clock::now();
+
+        if (block >= 0)
+            blockNanos.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    // The sources write exactly one block per bus block, so a primed lane should never run dry
+    const int underruns = BusShared::getInstance().getChannelHealth(channelBusID, health)
+        ? (int)(health.underruns - underrunsAtStart) : 0;
+
+    bus.releaseResources();
+    for (auto& strip : strips)
+        strip->releaseResources();
+
+    auto result = summarise(blockNanos, settings);
+    result.underruns = underruns;
+    return result;
+}
+
+static void printResult(const Settings& settings, const juce::String& name, const Result& result)
+{
+    if (settings.csv)
+    {
+        std::printf("%s,%.0f,%d,%d,%.2f,%.0f,%.0f,%.0f,%.2f,%.2f\n", name.toRawUTF8(), settings.sampleRate,
+            settings.blockSize, settings.numChannels, result.nsPerSample, result.p50, result.p99, result.max,
+            result.meanPercent, result.p99Percent);
+        return;
+    }
+
+    std::printf("  %-34s %9.2f %10.1f %10.1f %10.1f %8.2f %8.2f\n", name.toRawUTF8(), result.nsPerSample,
+        result.p50 * 1.0e-3, result.p99 * 1.0e-3, result.max * 1.0e-3, result.meanPercent, result.p99Percent);
+}
+
+static juce::String describe(const DDXStages& stages)
+{
+    if (!stages.enabled)
+        return "channel: DDX off";
+
+    juce::String name = "channel: EQ+saturation";
+    if (stages.harmonics) name << "+harmonics";
+    if (stages.noise) name << "+noise";
+    if (stages.intersample) name << "+intersample";
+    return name;
+}
+
+static bool parseArguments(int argc, char* argv[], Settings& settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        const juce::String value = hasValue ? juce::String(argv[i + 1]) : juce::String();
+
+        if (arg == "--csv") { settings.csv = true; continue; }
+        if (!hasValue) return false;
+
+        if (arg == "--rate") settings.sampleRate = juce::jlimit(8000.0, 768000.0, value.getDoubleValue());
+        else if (arg == "--block") settings.blockSize = juce::jlimit(1, 16384, value.getIntValue());
+        else if (arg == "--channels") settings.numChannels = juce::jlimit(2, 64, value.getIntValue());
+        else if (arg == "--seconds") settings.seconds = juce::jmax(0.1, value.getDoubleValue());
+        else if (arg == "--oversampling") settings.oversampling = value.getIntValue();
+        else if (arg == "--sources") settings.numSources = juce::jlimit(0, ChannelRingBuffer::maxLanes, value.getIntValue());
+        else if (arg == "--max-p99") settings.maxP99Percent = juce::jmax(0.0, value.getDoubleValue());
+        else return false;
+
+        ++i;
+    }
+
+    return settings.oversampling == 2 || settings.oversampling == 4 || settings.oversampling == 8;
+}
+
+int main(int argc, char* argv[])
+{
+    Settings settings;
+
+    if (!parseArguments(argc, argv, settings))
+    {
+        std::printf("Usage: ProcessorBenchmark [--rate Hz] [--block samples] [--channels n] [--seconds s]\n"
+                    "                          [--oversampling 2|4|8] [--sources n] [--csv] [--max-p99 percent]\n");
+        return 2;
+    }
+
+    // A bus of our own, so a session running on this machine neither hears us nor disturbs the figures
+    if (std::getenv("BUSALPHA5_SESSION") == nullptr)
+    {
+        const juce::String session = "benchmark-" + juce::String(juce::Time::currentTimeMillis());
+       #if JUCE_WINDOWS
+        _putenv_s("BUSALPHA5_SESSION", session.toRawUTF8());
+       #else
+        setenv("BUSALPHA5_SESSION", session.toRawUTF8(), 1);
+       #endif
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser; // The parameter state needs a message manager
+
+    const auto source = makeSource(settings);
+
+    if (settings.csv)
+        std::printf("configuration,rate,block,channels,ns_per_sample,p50_ns,p99_ns,max_ns,cpu_mean_percent,cpu_p99_percent\n");
+    else
+        std::printf("processBlock at %.0f Hz, %d-sample blocks, %d channels, %.1f s per run, %dx intersample\n"
+                    "  %-34s %9s %10s %10s %10s %8s %8s\n",
+            settings.sampleRate, settings.blockSize, settings.numChannels, settings.seconds, settings.oversampling,
+            "configuration", "ns/smp", "p50 us", "p99 us", "max us", "cpu %", "p99 %");
+
+    double worstP99Percent = 0.0;
+    int busUnderruns = 0;
+    auto report = [&](const juce::String& name, const Result& result)
+    {
+        printResult(settings, name, result);
+        worstP99Percent = juce::jmax(worstP99Percent, result.p99Percent);
+        busUnderruns += result.underruns;
+    };
+
+    report(describe({ false, false, false, false }), runChannel(settings, { false, false, false, false }, source));
+
+    for (int mask = 0; mask < 8; ++mask)
+    {
+        const DDXStages stages{ true, (mask & 1) != 0, (mask & 2) != 0, (mask & 4) != 0 };
+        report(describe(stages), runChannel(settings, stages, source));
+    }
+
+    report("bus: " + juce::String(settings.numSources) + " sources", runBus(settings, source));
+
+    // A host block at or past the target latency (20 ms at up to 96 kHz) must still play
+    if (settings.blockSize < 2048)
+    {
+        Settings longBlocks = settings;
+        longBlocks.blockSize = 2048;
+        const auto result = runBus(longBlocks, makeSource(longBlocks));
+
+        printResult(longBlocks, "bus: " + juce::String(settings.numSources) + " sources, 2048-sample blocks", result);
+        worstP99Percent = juce::jmax(worstP99Percent, result.p99Percent);
+        busUnderruns += result.underruns;
+    }
+
+    if (busUnderruns > 0)
+    {
+        std::fprintf(stderr, "bus lanes ran dry %d times while every source kept up\n", busUnderruns);
+        return 1;
+    }
+
+    if (settings.maxP99Percent > 0.0 && worstP99Percent > settings.maxP99Percent)
+    {
+        std::fprintf(stderr, "p99 reached %.2f%% of the real-time budget (limit %.2f%%)\n", worstP99Percent, settings.maxP99Percent);
+        return 1;
+    }
+
+    return 0;
+}